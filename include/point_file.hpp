@@ -0,0 +1,565 @@
+/* Reader and writer of point files: text (rbox output) and binary (QHPT), and writer of binary hull files (QHCH)
+ *
+ * Copyright (c) 2026, quickhull contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following condition is met:
+ * Redistributions of source code must retain the above copyright notice, this condition and the following disclaimer.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "thread_pool.hpp"
+
+#include <type_traits>
+#include <vector>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <charconv>
+#include <limits>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+struct binary_header // header of binary files: points (row-major coordinates follow) or convex hull (see write_hull)
+{
+
+    char magic_[4]; // "QHPT" for points, "QHCH" for convex hull
+    std::uint32_t value_size_; // sizeof(float) or sizeof(double), native byte order is assumed
+    std::uint64_t dimension_;
+    std::uint64_t count_; // count of points or of facets
+    std::uint64_t reserved_;
+
+};
+
+static_assert(sizeof(binary_header) == 32); // payload is aligned for double
+
+constexpr char binary_points_magic[4] = {'Q', 'H', 'P', 'T'};
+constexpr char binary_hull_magic[4] = {'Q', 'H', 'C', 'H'};
+
+template< typename value_type >
+bool
+write_points_header(std::ostream & _out,
+                    std::size_t const _dimension,
+                    std::size_t const _count) // _count rows of row-major payload should follow
+{
+    static_assert(std::is_same< value_type, float >::value || std::is_same< value_type, double >::value);
+    binary_header header_{};
+    std::copy_n(binary_points_magic, 4, header_.magic_);
+    header_.value_size_ = sizeof(value_type);
+    header_.dimension_ = _dimension;
+    header_.count_ = _count;
+    _out.write(reinterpret_cast< char const * >(&header_), sizeof(header_));
+    return !!_out;
+}
+
+template< typename value_type >
+bool
+write_points(std::ostream & _out,
+             value_type const * const _coordinates, // row-major
+             std::size_t const _dimension,
+             std::size_t const _count)
+{
+    write_points_header< value_type >(_out, _dimension, _count);
+    _out.write(reinterpret_cast< char const * >(_coordinates), std::streamsize(sizeof(value_type) * _dimension * _count));
+    return !!_out;
+}
+
+template< typename quick_hull_type, typename point_index >
+bool
+write_hull(std::ostream & _out,
+           quick_hull_type const & _quick_hull,
+           point_index && _point_index) // _point_index(point_iterator) is index of the point in the input
+{ // payload: facets count * dimension vertices (uint32), the same for neighbouring facets (uint32, i-th lies against i-th vertex), facets count * (dimension + 1) equations (normal, offset)
+    using value_type = std::decay_t< decltype(_quick_hull.eps) >;
+    static_assert(std::is_same< value_type, float >::value || std::is_same< value_type, double >::value);
+    std::size_t const dimension_ = _quick_hull.dimension_;
+    auto const & facets_ = _quick_hull.facets_;
+    binary_header header_{};
+    std::copy_n(binary_hull_magic, 4, header_.magic_);
+    header_.value_size_ = sizeof(value_type);
+    header_.dimension_ = dimension_;
+    header_.count_ = facets_.size();
+    _out.write(reinterpret_cast< char const * >(&header_), sizeof(header_));
+    std::vector< std::uint32_t > indices_;
+    indices_.reserve(facets_.size() * dimension_);
+    for (auto const & facet_ : facets_) {
+        for (auto const & vertex_ : facet_.vertices_) {
+            indices_.push_back(std::uint32_t(_point_index(vertex_)));
+        }
+    }
+    _out.write(reinterpret_cast< char const * >(indices_.data()), std::streamsize(sizeof(std::uint32_t) * indices_.size()));
+    indices_.clear();
+    for (auto const & facet_ : facets_) {
+        for (std::size_t v = 0; v < dimension_; ++v) {
+            indices_.push_back(std::uint32_t(facet_.neighbours_[v]));
+        }
+    }
+    _out.write(reinterpret_cast< char const * >(indices_.data()), std::streamsize(sizeof(std::uint32_t) * indices_.size()));
+    for (auto const & facet_ : facets_) {
+        _out.write(reinterpret_cast< char const * >(facet_.normal_.data()), std::streamsize(sizeof(value_type) * dimension_));
+        _out.write(reinterpret_cast< char const * >(&facet_.D), sizeof(value_type));
+    }
+    return !!_out;
+}
+
+template< typename value_type >
+struct point_file // "dimension / count / count rows" text format of rbox and randombox (rows starting with '#' are comments) or binary one (see write_points)
+{
+
+    using size_type = std::size_t;
+
+    size_type dimension_ = 0;
+    size_type count_ = 0; // count of rows, comments included
+    std::string header_; // rest of the dimension line (e.g. rbox command line)
+    std::vector< value_type > coordinates_; // row-major, dimension_ values per point, empty if data() points into memory-mapped binary file
+    std::string error_; // reason of the failure
+
+    point_file() = default;
+    point_file(point_file const &) = delete;
+    point_file & operator = (point_file const &) = delete;
+
+    ~point_file()
+    {
+        unmap();
+    }
+
+    value_type const *
+    data() const // row-major coordinates of the points
+    {
+        return data_;
+    }
+
+    size_type
+    size() const // count of points
+    {
+        return size_;
+    }
+
+    bool
+    open(char const * const _path,
+         thread_pool * const _thread_pool = nullptr) // the file is memory-mapped, if possible: binary file of the same value_type is not copied
+    {
+        unmap();
+#if defined(__unix__) || defined(__APPLE__)
+        int const fd = ::open(_path, O_RDONLY);
+        if (fd < 0) {
+            return fail(std::string("cannot open file '") + _path + "'");
+        }
+        struct ::stat stat_;
+        if ((::fstat(fd, &stat_) != 0) || !S_ISREG(stat_.st_mode)) { // e.g. named pipe
+            ::close(fd);
+            std::ifstream ifs_(_path, std::ios::binary);
+            return read(ifs_, _thread_pool);
+        }
+        size_type const length_ = size_type(stat_.st_size);
+        if (length_ == 0) {
+            ::close(fd);
+            return parse(nullptr, nullptr, _thread_pool);
+        }
+        void * const map_ = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (map_ == MAP_FAILED) {
+            return fail(std::string("cannot map file '") + _path + "'");
+        }
+        ::madvise(map_, length_, MADV_SEQUENTIAL);
+        map_address_ = map_;
+        map_size_ = length_;
+        char const * const first_ = static_cast< char const * >(map_);
+        bool const success_ = parse(first_, first_ + length_, _thread_pool, true);
+        if (!success_ || (data_ == coordinates_.data())) {
+            unmap(); // not referred
+        }
+        return success_;
+#else
+        std::ifstream ifs_(_path, std::ios::binary);
+        if (!ifs_.is_open()) {
+            return fail(std::string("cannot open file '") + _path + "'");
+        }
+        return read(ifs_, _thread_pool);
+#endif
+    }
+
+    bool
+    read(std::istream & _in,
+         thread_pool * const _thread_pool = nullptr) // whole the stream is read by large blocks
+    {
+        constexpr size_type block_size = size_type(1) << 20;
+        buffer_.clear();
+        for (;;) {
+            size_type const length_ = buffer_.size();
+            buffer_.resize(length_ + block_size);
+            _in.read(buffer_.data() + length_, std::streamsize(block_size));
+            buffer_.resize(length_ + size_type(_in.gcount()));
+            if (!_in) {
+                break;
+            }
+        }
+        if (_in.bad()) {
+            return fail("input: read error");
+        }
+        return parse(buffer_.data(), buffer_.data() + buffer_.size(), _thread_pool);
+    }
+
+    bool
+    parse(char const * _first,
+          char const * const _last,
+          thread_pool * const _thread_pool = nullptr,
+          bool const _persistent = false) // if _persistent, then binary payload of the same value_type is referred instead of copying
+    {
+        dimension_ = 0;
+        count_ = 0;
+        header_.clear();
+        coordinates_.clear();
+        error_.clear();
+        data_ = nullptr;
+        size_ = 0;
+        if ((sizeof(binary_header) <= size_type(_last - _first)) && std::equal(binary_points_magic, binary_points_magic + 4, _first)) {
+            return parse_binary(_first, _last, _persistent);
+        }
+        {
+            char const * const eol = end_of_line(_first, _last);
+            if (_first == _last) {
+                return fail("input: missing dimension line");
+            }
+            char const * const c = parse_size(_first, eol, dimension_);
+            if (!c || (dimension_ == 0)) {
+                return fail("input: dimension format");
+            }
+            header_.assign(c, trim(c, eol));
+            _first = next_line(eol, _last);
+        }
+        {
+            char const * const eol = end_of_line(_first, _last);
+            if (_first == _last) {
+                return fail("input: missing count line");
+            }
+            if (!parse_size(_first, eol, count_)) {
+                return fail("input: format of count");
+            }
+            _first = next_line(eol, _last);
+        }
+        constexpr size_type part_size = size_type(1) << 20; // minimal count of bytes parsed by single task
+        size_type const length_ = size_type(_last - _first);
+        size_type parts = 1;
+        if (_thread_pool) {
+            parts = std::max(std::min(length_ / part_size, _thread_pool->size()), size_type(1));
+        }
+        if (parts_.size() < parts) {
+            parts_.resize(parts);
+        }
+        char const * first_ = _first;
+        for (size_type p = 0; p < parts; ++p) { // split at newline boundaries
+            part & part_ = parts_[p];
+            part_.first_ = first_;
+            if (p + 1 == parts) {
+                first_ = _last;
+            } else {
+                first_ = std::max(first_, _first + (length_ * (p + 1)) / parts);
+                if (first_ != part_.first_) {
+                    first_ = next_line(end_of_line(first_ - 1, _last), _last);
+                }
+            }
+            part_.last_ = first_;
+        }
+        auto const parse_part = [&] (size_type const p, size_type)
+        {
+            part & part_ = parts_[p];
+            parse_rows(part_, std::numeric_limits< size_type >::max());
+        };
+        if (parts == 1) {
+            parse_part(0, 0);
+        } else {
+            _thread_pool->parallel_for(parts, parse_part);
+        }
+        size_type row_ = 0;
+        size_type points_ = 0;
+        size_type used_ = 0; // count of parts containing rows [0; count_)
+        while ((row_ < count_) && (used_ < parts)) {
+            part & part_ = parts_[used_];
+            ++used_;
+            size_type const rest_ = count_ - row_;
+            if (part_.error_ < rest_) {
+                return fail("input: bad coordinate value at row " + std::to_string(row_ + part_.error_ + 1) + " of data");
+            }
+            if ((rest_ < part_.rows_) || (part_.error_ != part::none)) { // rows after the last one are ignored
+                parse_rows(part_, rest_);
+            }
+            row_ += part_.rows_;
+            points_ += part_.coordinates_.size() / dimension_;
+        }
+        if (row_ < count_) {
+            return fail("input: wrong line count");
+        }
+        if (used_ < 2) {
+            if (used_ == 1) {
+                coordinates_.swap(parts_.front().coordinates_);
+            }
+            data_ = coordinates_.data();
+            size_ = points_;
+            return true;
+        }
+        coordinates_.resize(points_ * dimension_);
+        auto const gather = [&] (size_type const p, size_type)
+        {
+            size_type offset_ = 0;
+            for (size_type q = 0; q < p; ++q) {
+                offset_ += parts_[q].coordinates_.size();
+            }
+            std::copy(std::cbegin(parts_[p].coordinates_), std::cend(parts_[p].coordinates_), std::next(std::begin(coordinates_), std::ptrdiff_t(offset_)));
+        };
+        _thread_pool->parallel_for(used_, gather);
+        data_ = coordinates_.data();
+        size_ = points_;
+        return true;
+    }
+
+private :
+
+    struct part
+    {
+
+        static constexpr size_type none = std::numeric_limits< size_type >::max();
+
+        char const * first_ = nullptr;
+        char const * last_ = nullptr;
+        std::vector< value_type > coordinates_;
+        size_type rows_ = 0; // rows are counted, while there is no errors
+        size_type error_ = none; // local index of the first bad row
+
+    };
+
+    std::vector< char > buffer_;
+    std::vector< part > parts_;
+    value_type const * data_ = nullptr;
+    size_type size_ = 0;
+    void * map_address_ = nullptr;
+    size_type map_size_ = 0;
+
+    bool
+    fail(std::string const & _error)
+    {
+        error_ = _error;
+        return false;
+    }
+
+    void
+    unmap()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        if (map_address_) {
+            if (data_ != coordinates_.data()) { // data_ refers to the mapping
+                data_ = nullptr;
+                size_ = 0;
+            }
+            ::munmap(map_address_, map_size_);
+            map_address_ = nullptr;
+            map_size_ = 0;
+        }
+#endif
+    }
+
+    template< typename type >
+    void
+    load(char const * const _payload)
+    {
+        coordinates_.resize(size_ * dimension_);
+        for (size_type i = 0; i < coordinates_.size(); ++i) {
+            type value_;
+            std::memcpy(&value_, _payload + i * sizeof(type), sizeof(type));
+            coordinates_[i] = value_type(value_);
+        }
+        data_ = coordinates_.data();
+    }
+
+    bool
+    parse_binary(char const * const _first,
+                 char const * const _last,
+                 bool const _persistent)
+    {
+        binary_header binary_header_;
+        std::memcpy(&binary_header_, _first, sizeof(binary_header_));
+        if ((binary_header_.value_size_ != sizeof(float)) && (binary_header_.value_size_ != sizeof(double))) {
+            return fail("input: unsupported value type of binary file");
+        }
+        if (binary_header_.dimension_ == 0) {
+            return fail("input: dimension format");
+        }
+        size_type const payload_size_ = size_type(_last - _first) - sizeof(binary_header_);
+        if (payload_size_ / binary_header_.value_size_ / binary_header_.dimension_ < binary_header_.count_) {
+            return fail("input: wrong line count");
+        }
+        dimension_ = size_type(binary_header_.dimension_);
+        count_ = size_type(binary_header_.count_);
+        size_ = count_;
+        char const * const payload_ = _first + sizeof(binary_header_);
+        if (binary_header_.value_size_ == sizeof(value_type)) {
+            if (_persistent && ((reinterpret_cast< std::uintptr_t >(payload_) % alignof(value_type)) == 0)) {
+                data_ = reinterpret_cast< value_type const * >(payload_); // zero-copy
+            } else {
+                coordinates_.resize(size_ * dimension_);
+                std::memcpy(coordinates_.data(), payload_, coordinates_.size() * sizeof(value_type));
+                data_ = coordinates_.data();
+            }
+        } else if (binary_header_.value_size_ == sizeof(float)) {
+            load< float >(payload_);
+        } else {
+            load< double >(payload_);
+        }
+        return true;
+    }
+
+    static
+    char const *
+    end_of_line(char const * const _first,
+                char const * const _last)
+    {
+        if (_first == _last) {
+            return _last;
+        }
+        void const * const eol = std::memchr(_first, '\n', size_type(_last - _first));
+        return (eol ? static_cast< char const * >(eol) : _last);
+    }
+
+    static
+    char const *
+    next_line(char const * const _eol,
+              char const * const _last)
+    {
+        return ((_eol == _last) ? _last : (_eol + 1));
+    }
+
+    static
+    char const *
+    skip_spaces(char const * _first,
+                char const * const _last)
+    {
+        while ((_first != _last) && ((*_first == ' ') || (*_first == '\t') || (*_first == '\r'))) {
+            ++_first;
+        }
+        return _first;
+    }
+
+    static
+    char const *
+    trim(char const * const _first,
+         char const * _last)
+    {
+        while ((_first != _last) && (_last[-1] == '\r')) {
+            --_last;
+        }
+        return _last;
+    }
+
+    static
+    char const *
+    parse_size(char const * _first,
+               char const * const _last,
+               size_type & _value) // returns nullptr on failure
+    {
+        _first = skip_spaces(_first, _last);
+        auto const result_ = std::from_chars(_first, _last, _value);
+        if (result_.ec != std::errc()) {
+            return nullptr;
+        }
+        return result_.ptr;
+    }
+
+    static
+    char const *
+    parse_value(char const * _first,
+                char const * const _last,
+                value_type & _value) // returns nullptr on failure
+    {
+        _first = skip_spaces(_first, _last);
+        if ((_first != _last) && (*_first == '+')) {
+            ++_first;
+        }
+#if defined(__cpp_lib_to_chars)
+        auto const result_ = std::from_chars(_first, _last, _value);
+        if (result_.ec != std::errc()) {
+            return nullptr;
+        }
+        return result_.ptr;
+#else
+        char token_[128]; // null-terminated copy of the token for strto*
+        size_type length_ = 0;
+        while (_first + length_ != _last) {
+            char const c = _first[length_];
+            if ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n')) {
+                break;
+            }
+            if (!(length_ + 1 < sizeof(token_))) { // too long to be a number
+                return nullptr;
+            }
+            token_[length_++] = c;
+        }
+        token_[length_] = '\0';
+        char * end_ = nullptr;
+        if constexpr (std::is_same< value_type, float >::value) {
+            _value = std::strtof(token_, &end_);
+        } else if constexpr (std::is_same< value_type, double >::value) {
+            _value = std::strtod(token_, &end_);
+        } else {
+            _value = value_type(std::strtold(token_, &end_));
+        }
+        if (end_ == token_) {
+            return nullptr;
+        }
+        return _first + (end_ - token_);
+#endif
+    }
+
+    void
+    parse_rows(part & _part,
+               size_type const _rows) const // at most _rows rows are parsed
+    {
+        _part.coordinates_.clear();
+        _part.rows_ = 0;
+        _part.error_ = part::none;
+        char const * first_ = _part.first_;
+        char const * const last_ = _part.last_;
+        while ((first_ != last_) && (_part.rows_ < _rows)) {
+            char const * const eol = end_of_line(first_, last_);
+            if (*first_ != '#') {
+                for (size_type j = 0; j < dimension_; ++j) {
+                    _part.coordinates_.emplace_back();
+                    first_ = parse_value(first_, eol, _part.coordinates_.back());
+                    if (!first_) {
+                        _part.coordinates_.resize(_part.coordinates_.size() - j - 1);
+                        _part.error_ = _part.rows_;
+                        return;
+                    }
+                }
+            }
+            ++_part.rows_;
+            first_ = next_line(eol, last_);
+        }
+    }
+
+};
@@ -23,69 +23,439 @@
 
 #include <type_traits>
 #include <vector>
-#include <deque>
+#include <array>
 #include <list>
-#include <map>
-#include <unordered_set>
-#include <unordered_map>
 #include <iterator>
 #include <memory>
 #include <algorithm>
 #include <numeric>
 #include <utility>
 #include <functional>
+#include <limits>
+#include <istream>
+#include <ostream>
+#include <chrono>
 
 #include <cstdint>
 #include <cmath>
 #include <cassert>
 
+#include "thread_pool.hpp"
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+template< std::size_t dimension >
+struct quick_hull_dimension // dimensionality known at compile time: all the loops over dimension_ have constant trip count
+{
+
+    static constexpr std::size_t dimension_ = dimension;
+
+    explicit
+    quick_hull_dimension(std::size_t const _dimension)
+    {
+        set_dimension(_dimension);
+    }
+
+    void
+    set_dimension(std::size_t const _dimension) const
+    {
+        assert(_dimension == dimension_);
+        static_cast< void >(_dimension);
+    }
+
+};
+
+template<>
+struct quick_hull_dimension< 0 > // dimensionality known at runtime only
+{
+
+    std::size_t dimension_; // changed by reset() only
+
+    explicit
+    quick_hull_dimension(std::size_t const _dimension)
+        : dimension_(_dimension)
+    { ; }
+
+    void
+    set_dimension(std::size_t const _dimension)
+    {
+        dimension_ = _dimension;
+    }
+
+};
+
+template< typename type >
+struct row // coordinates of a point, stored in a row of row-major matrix
+{
+
+    type const * first_;
+    type const * last_;
+
+    type const * begin() const { return first_; }
+    type const * end() const { return last_; }
+    std::size_t size() const { return std::size_t(last_ - first_); }
+    type const & operator [] (std::size_t const i) const { return first_[i]; }
+
+};
+
+template< typename type >
+struct row_iterator // iterator over rows of contiguous row-major matrix with arbitrary stride (at least width), e.g. point_iterator over flat buffer of coordinates
+{
+
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = row< type >;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    row_iterator() = default;
+
+    row_iterator(type const * const _first,
+                 std::size_t const _width,
+                 std::size_t const _stride)
+        : first_(_first)
+        , width_(_width)
+        , stride_(difference_type(_stride))
+    {
+        assert(!(_stride < _width));
+    }
+
+    type const * data() const { return first_; }
+
+    reference operator * () const { return {first_, first_ + width_}; }
+    reference operator [] (difference_type const n) const { return *(*this + n); }
+
+    row_iterator & operator ++ () { first_ += stride_; return *this; }
+    row_iterator & operator -- () { first_ -= stride_; return *this; }
+    row_iterator operator ++ (int) { row_iterator it = *this; ++*this; return it; }
+    row_iterator operator -- (int) { row_iterator it = *this; --*this; return it; }
+    row_iterator & operator += (difference_type const n) { first_ += n * stride_; return *this; }
+    row_iterator & operator -= (difference_type const n) { first_ -= n * stride_; return *this; }
+    row_iterator operator + (difference_type const n) const { row_iterator it = *this; return (it += n); }
+    row_iterator operator - (difference_type const n) const { row_iterator it = *this; return (it -= n); }
+    friend row_iterator operator + (difference_type const n, row_iterator const & _it) { return _it + n; }
+    difference_type operator - (row_iterator const & _rhs) const { return (first_ - _rhs.first_) / stride_; }
+
+    bool operator == (row_iterator const & _rhs) const { return (first_ == _rhs.first_); }
+    bool operator != (row_iterator const & _rhs) const { return (first_ != _rhs.first_); }
+    bool operator < (row_iterator const & _rhs) const { return (first_ < _rhs.first_); }
+    bool operator > (row_iterator const & _rhs) const { return (_rhs.first_ < first_); }
+    bool operator <= (row_iterator const & _rhs) const { return !(_rhs.first_ < first_); }
+    bool operator >= (row_iterator const & _rhs) const { return !(first_ < _rhs.first_); }
+
+private :
+
+    type const * first_ = nullptr;
+    std::size_t width_ = 0;
+    difference_type stride_ = 0;
+
+};
+
+template< typename point_iterator, typename index, typename points >
+struct indexed_span // points, referenced by contiguous range of their indices, points[i] yields point_iterator of i-th point
+{
+
+    struct iterator
+    {
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = point_iterator;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = point_iterator;
+
+        points const * points_;
+        index const * index_;
+
+        reference operator * () const { return (*points_)[*index_]; }
+        iterator & operator ++ () { ++index_; return *this; }
+        iterator operator ++ (int) { iterator it = *this; ++index_; return it; }
+        bool operator == (iterator const & _rhs) const { return (index_ == _rhs.index_); }
+        bool operator != (iterator const & _rhs) const { return (index_ != _rhs.index_); }
+
+    };
+
+    indexed_span(points const * const _points,
+                 index const * const _first,
+                 std::size_t const _size)
+        : points_(_points)
+        , first_(_first)
+        , last_(_first + _size)
+    { ; }
+
+    iterator begin() const { return {points_, first_}; }
+    iterator end() const { return {points_, last_}; }
+    std::size_t size() const { return std::size_t(last_ - first_); }
+    bool empty() const { return (first_ == last_); }
+    point_iterator front() const { return (*points_)[*first_]; }
+    point_iterator back() const { return (*points_)[*(last_ - 1)]; }
+    point_iterator operator [] (std::size_t const i) const { return (*points_)[first_[i]]; }
+    index const * indices() const { return first_; }
+
+private :
+
+    points const * points_;
+    index const * first_;
+    index const * last_;
+
+};
+
+#if defined(QUICKHULL_STATISTICS)
+#define QUICKHULL_STATISTICS_DO(statement) statement
+#else
+#define QUICKHULL_STATISTICS_DO(statement)
+#endif
+
+struct quick_hull_statistics // counters of hot paths and wall time of phases, gathered by quick_hull::statistics_ if QUICKHULL_STATISTICS is defined
+{
+
+    using size_type = std::size_t;
+    using duration = std::chrono::steady_clock::duration;
+
+    size_type det_calls_ = 0;
+    size_type hyperplane_equations_ = 0; // set_hyperplane_equation calls
+    size_type partition_distances_ = 0; // distances from points to facets calculated in partition
+    size_type apexes_ = 0;
+    size_type visible_facets_ = 0; // total over apexes
+    size_type max_visible_facets_ = 0; // per apex
+    size_type horizon_ridges_ = 0; // total over apexes
+    size_type ridge_lookups_ = 0; // lookups of ridges of new facets in the hash table
+    size_type ridge_probes_ = 0; // total probe length of the lookups
+    size_type max_ridge_probes_ = 0; // the longest probe sequence
+    size_type facets_added_ = 0;
+    size_type removed_facets_reused_ = 0; // facets added into slots of removed ones
+    size_type peak_facets_ = 0; // maximal size of facets_, removed facets included
+    size_type rebuilds_ = 0; // insert_points calls, which fell back to the rebuild of the hull from scratch
+
+    duration affine_basis_time_{};
+    duration initial_simplex_time_{};
+    duration convex_hull_time_{}; // create_convex_hull or insert_points, consists of the following phases mostly
+    duration horizon_time_{}; // find_horizon (and choice of apexes with disjoint visible regions)
+    duration cone_time_{}; // process_visibles: new facets, their hyperplanes and adjacency
+    duration partition_time_{}; // partition of orphaned points among new facets (or location of inserted points)
+    duration compactify_time_{};
+
+    struct stopwatch
+    {
+
+        std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+
+        duration
+        lap() // time since construction or since previous lap
+        {
+            std::chrono::steady_clock::time_point const now_ = std::chrono::steady_clock::now();
+            duration const lap_ = now_ - start_;
+            start_ = now_;
+            return lap_;
+        }
+
+    };
+
+    struct timer // adds wall time of its scope to the duration
+    {
+
+        duration & duration_;
+        stopwatch stopwatch_;
+
+        timer(duration & _duration)
+            : duration_(_duration)
+        { ; }
+
+        timer(timer const &) = delete;
+        timer & operator = (timer const &) = delete;
+
+        ~timer()
+        {
+            duration_ += stopwatch_.lap();
+        }
+
+    };
+
+    void
+    visit_apex(size_type const _visible_facets,
+               size_type const _horizon_ridges)
+    {
+        ++apexes_;
+        visible_facets_ += _visible_facets;
+        max_visible_facets_ = std::max(max_visible_facets_, _visible_facets);
+        horizon_ridges_ += _horizon_ridges;
+    }
+
+    quick_hull_statistics &
+    operator += (quick_hull_statistics const & _other) // merge counters of another instance (e.g. of another worker)
+    {
+        det_calls_ += _other.det_calls_;
+        hyperplane_equations_ += _other.hyperplane_equations_;
+        partition_distances_ += _other.partition_distances_;
+        apexes_ += _other.apexes_;
+        visible_facets_ += _other.visible_facets_;
+        max_visible_facets_ = std::max(max_visible_facets_, _other.max_visible_facets_);
+        horizon_ridges_ += _other.horizon_ridges_;
+        ridge_lookups_ += _other.ridge_lookups_;
+        ridge_probes_ += _other.ridge_probes_;
+        max_ridge_probes_ = std::max(max_ridge_probes_, _other.max_ridge_probes_);
+        facets_added_ += _other.facets_added_;
+        removed_facets_reused_ += _other.removed_facets_reused_;
+        peak_facets_ = std::max(peak_facets_, _other.peak_facets_);
+        rebuilds_ += _other.rebuilds_;
+        affine_basis_time_ += _other.affine_basis_time_;
+        initial_simplex_time_ += _other.initial_simplex_time_;
+        convex_hull_time_ += _other.convex_hull_time_;
+        horizon_time_ += _other.horizon_time_;
+        cone_time_ += _other.cone_time_;
+        partition_time_ += _other.partition_time_;
+        compactify_time_ += _other.compactify_time_;
+        return *this;
+    }
+
+    template< typename visitor >
+    void
+    visit(visitor && _visitor) const // _visitor(name, value) for each counter and each phase (in microseconds)
+    {
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        _visitor("det_calls", det_calls_);
+        _visitor("hyperplane_equations", hyperplane_equations_);
+        _visitor("partition_distances", partition_distances_);
+        _visitor("apexes", apexes_);
+        _visitor("visible_facets", visible_facets_);
+        _visitor("max_visible_facets", max_visible_facets_);
+        _visitor("horizon_ridges", horizon_ridges_);
+        _visitor("ridge_lookups", ridge_lookups_);
+        _visitor("ridge_probes", ridge_probes_);
+        _visitor("max_ridge_probes", max_ridge_probes_);
+        _visitor("facets_added", facets_added_);
+        _visitor("removed_facets_reused", removed_facets_reused_);
+        _visitor("peak_facets", peak_facets_);
+        _visitor("rebuilds", rebuilds_);
+        _visitor("affine_basis_us", size_type(duration_cast< microseconds >(affine_basis_time_).count()));
+        _visitor("initial_simplex_us", size_type(duration_cast< microseconds >(initial_simplex_time_).count()));
+        _visitor("convex_hull_us", size_type(duration_cast< microseconds >(convex_hull_time_).count()));
+        _visitor("horizon_us", size_type(duration_cast< microseconds >(horizon_time_).count()));
+        _visitor("cone_us", size_type(duration_cast< microseconds >(cone_time_).count()));
+        _visitor("partition_us", size_type(duration_cast< microseconds >(partition_time_).count()));
+        _visitor("compactify_us", size_type(duration_cast< microseconds >(compactify_time_).count()));
+    }
+
+};
+
+inline
+std::ostream &
+operator << (std::ostream & _out, quick_hull_statistics const & _statistics)
+{
+    _statistics.visit([&] (char const * const _name, std::size_t const _value)
+    {
+        _out << _name << " = " << _value << '\n';
+    });
+    return _out;
+}
+
 template< typename point_iterator,
-          typename value_type = std::decay_t< decltype(*std::cbegin(std::declval< typename std::iterator_traits< point_iterator >::value_type >())) > >
+          typename value_type = std::decay_t< decltype(*std::cbegin(std::declval< typename std::iterator_traits< point_iterator >::value_type >())) >,
+          std::size_t static_dimension = 0, // 0 means dimensionality is specified at runtime
+          typename allocator = std::allocator< value_type > > // all the internal containers use (rebound) copies of the allocator, e.g. std::pmr::polymorphic_allocator
 struct quick_hull
+    : quick_hull_dimension< static_dimension >
 {
 
     static_assert(std::is_base_of< std::forward_iterator_tag, typename std::iterator_traits< point_iterator >::iterator_category >::value,
                   "multipass guarantee required");
+    static_assert(static_dimension != 1, "dimensionality must be greater then one");
 
     using size_type = std::size_t;
 
-    size_type const dimension_;
-    value_type const & eps;
+    using quick_hull_dimension< static_dimension >::dimension_;
+    value_type eps; // copy of constructor (or reset()) argument
 
     value_type const zero = value_type(0);
     value_type const one = value_type(1);
 
-    using vector = std::vector< value_type >;
+    bool cofactor_hyperplanes_ = false; // calculate equations of hyperplanes by means of (d + 1) determinants instead of single QR decomposition
+    bool monotone_chain_ = true; // in 2D build convex polygon by means of Andrew's monotone chain instead of quickhull
+    thread_pool * thread_pool_ = nullptr; // if specified, then large sets of points are partitioned concurrently
+    size_type concurrent_apexes_ = 1; // if greater then one (and thread_pool_ is specified), then up to the count of apexes are processed per round
+#if defined(QUICKHULL_STATISTICS)
+    quick_hull_statistics statistics_; // accumulated until cleared (statistics_ = {}), reset() retains it
+#endif
+
+    using allocator_type = allocator;
+
+    template< typename type >
+    using array = std::vector< type, typename std::allocator_traits< allocator >::template rebind_alloc< type > >;
+
+    using vector = array< value_type >;
+
+    template< typename type >
+    using dimension_array = std::conditional_t< (static_dimension == 0), array< type >, std::array< type, static_dimension > >; // dimension_ elements
 
 private :
 
+    allocator const allocator_;
+
+    template< typename type >
+    dimension_array< type >
+    make_array() const // to be allocated
+    {
+        if constexpr (static_dimension == 0) {
+            return dimension_array< type >(allocator_);
+        } else {
+            return {};
+        }
+    }
+
+    template< typename type >
+    void
+    allocate(array< type > & _array) const
+    {
+        _array.resize(dimension_);
+    }
+
+    template< typename type >
+    void
+    allocate(std::array< type, static_dimension > &) const
+    { ; }
+
     using vrow = value_type *;
     using crow = value_type const *;
-    using matrix = std::vector< vrow >;
+    using matrix = dimension_array< vrow >;
 
-    vector storage_;
+    vector storage_; // rows below point into storage_: they remain valid when quick_hull is moved
     vrow inner_point_;
-    matrix matrix_;
-    matrix det_matrix_;
-    matrix shadow_matrix_;
+    matrix matrix_ = make_array< vrow >();
+    matrix det_matrix_ = make_array< vrow >();
+    matrix shadow_matrix_ = make_array< vrow >();
 
 public :
 
-    quick_hull(size_type, value_type const &&) = delete; // bind eps to lvalue only
-
     quick_hull(size_type const _dimension,
-               value_type const & _eps)
-        : dimension_(_dimension)
+               value_type const & _eps,
+               allocator const & _allocator = allocator())
+        : quick_hull_dimension< static_dimension >(_dimension)
         , eps(_eps)
-        , storage_(dimension_ * dimension_ * 2 + dimension_)
-        , inner_point_(storage_.data())
-        , matrix_(dimension_)
-        , det_matrix_(dimension_)
-        , shadow_matrix_(dimension_)
-        , vertices_hashes_(dimension_)
+        , allocator_(_allocator)
+        , storage_(allocator_)
+        , facets_(_dimension, allocator_)
+    {
+        layout();
+    }
+
+private :
+
+    void
+    layout() // dimension_-dependent scratch storage
     {
         assert(1 < dimension_);
         assert(!(eps < zero));
+        storage_.resize(dimension_ * dimension_ * 2 + dimension_);
+        inner_point_ = storage_.data();
+        allocate(matrix_);
+        allocate(det_matrix_);
+        allocate(shadow_matrix_);
+        allocate(vertices_hashes_);
+        allocate(sorted_vertices_);
+        allocate(ridge_key_);
         for (vrow & row_ : matrix_) {
             row_ = inner_point_;
             inner_point_ += dimension_;
@@ -97,24 +467,136 @@ public :
         assert(inner_point_ + dimension_ == &storage_.back() + 1);
     }
 
-    using point_array = std::vector< point_iterator >;
-    using point_list  = std::list< point_iterator >;
-    using point_deque = std::deque< point_iterator >;
-    using facet_array = std::vector< size_type >;
+public :
 
-    struct facet // (d - 1)-dimensional face
+    allocator_type
+    get_allocator() const
     {
+        return allocator_;
+    }
 
-        // each neighbouring facet lies against corresponding vertex and vice versa
-        point_array vertices_; // dimension_ points (oriented)
-        facet_array neighbours_; // dimension_ neighbouring facets
+    using point_array = array< point_iterator >;
+    using point_list  = std::list< point_iterator, typename std::allocator_traits< allocator >::template rebind_alloc< point_iterator > >;
+    using point_index = std::uint32_t; // index of point in order of addition
+    using point_indices = array< point_index >;
+    using facet_array = array< size_type >;
+
+    struct point_table // point_iterator of a point by its index
+    {
 
-        point_list outside_; // if empty, then is convex hull's facet, else the first point (i.e. outside_.front()) is the furthest point from this facet
-        point_deque coplanar_; // containing coplanar points and vertices of coplanar facets as well
+        explicit
+        point_table(allocator const & _allocator)
+            : iterators_(_allocator)
+        { ; }
+
+        point_array iterators_; // stored points
+        value_type const * rows_ = nullptr; // if not nullptr, then the points are rows of the buffer of the caller, no iterators are stored
+        size_type width_ = 0;
+        size_type stride_ = 0;
+        size_type rows_count_ = 0;
+
+        static constexpr bool rows_allowed = std::is_constructible< point_iterator, value_type const *, size_type, size_type >::value;
+
+        size_type
+        size() const
+        {
+            return (rows_ ? rows_count_ : iterators_.size());
+        }
+
+        point_iterator
+        operator [] (size_type const p) const
+        {
+            if constexpr (rows_allowed) {
+                if (rows_) {
+                    assert(p < rows_count_);
+                    return point_iterator(rows_ + p * stride_, width_, stride_);
+                }
+            }
+            return iterators_[p];
+        }
+
+        void
+        clear()
+        {
+            iterators_.clear();
+            rows_ = nullptr;
+            rows_count_ = 0;
+        }
+
+    };
+
+    using point_span = indexed_span< point_iterator, point_index, point_table >;
+
+    template< typename type >
+    struct span // contiguous range of elements, owned by someone else
+    {
+
+        span(type * const _first, size_type const _size)
+            : first_(_first)
+            , last_(_first + _size)
+        { ; }
+
+        template< typename other, typename = std::enable_if_t< std::is_convertible< other *, type * >::value > >
+        span(span< other > const & _other)
+            : first_(_other.begin())
+            , last_(_other.end())
+        { ; }
+
+        type * begin() const { return first_; }
+        type * end() const { return last_; }
+        type * data() const { return first_; }
+        size_type size() const { return size_type(last_ - first_); }
+        bool empty() const { return (first_ == last_); }
+        type & front() const { return *first_; }
+        type & back() const { return *(last_ - 1); }
+        type & operator [] (size_type const i) const { return first_[i]; }
+
+    private :
+
+        type * first_;
+        type * last_;
+
+    };
+
+    template< bool is_const >
+    struct basic_facet // view of (d - 1)-dimensional face, stored in facets_
+    {
+
+        template< typename type >
+        using cv = std::conditional_t< is_const, type const, type >;
+
+        // each neighbouring facet lies against corresponding vertex and vice versa
+        point_span vertices_; // dimension_ points (oriented)
+        span< cv< size_type > > neighbours_; // dimension_ neighbouring facets
 
         // equation of supporting hyperplane
-        vector normal_; // components of normalized normal vector
-        value_type D; // distance from the origin to the hyperplane
+        span< cv< value_type > > normal_; // components of normalized normal vector
+        cv< value_type > & D; // distance from the origin to the hyperplane
+
+        // [outside_begin_; outside_end_) is a segment of outsides_ array
+        cv< size_type > & outside_begin_; // if the segment is empty, then is convex hull's facet, else the first point is the furthest point from this facet
+        cv< size_type > & outside_end_;
+        point_span coplanar_; // containing coplanar points and vertices of coplanar facets as well
+
+        basic_facet(point_span const & _vertices,
+                    span< cv< size_type > > const & _neighbours,
+                    span< cv< value_type > > const & _normal,
+                    cv< value_type > & _D,
+                    cv< size_type > & _outside_begin,
+                    cv< size_type > & _outside_end,
+                    point_span const & _coplanar)
+            : vertices_(_vertices)
+            , neighbours_(_neighbours)
+            , normal_(_normal)
+            , D(_D)
+            , outside_begin_(_outside_begin)
+            , outside_end_(_outside_end)
+            , coplanar_(_coplanar)
+        { ; }
+
+        basic_facet(basic_facet< false > const & _facet)
+            : basic_facet(_facet.vertices_, _facet.neighbours_, _facet.normal_, _facet.D, _facet.outside_begin_, _facet.outside_end_, _facet.coplanar_)
+        { ; }
 
         template< typename iterator >
         value_type
@@ -127,12 +609,184 @@ public :
 
     };
 
-    using facets = std::deque< facet >;
+    using facet = basic_facet< false >;
+    using const_facet = basic_facet< true >;
+
+    struct facets // structure of arrays: vertices, neighbours and normals of f-th facet are f-th dimension_-strided rows
+        : quick_hull_dimension< static_dimension >
+    {
+
+        using quick_hull_dimension< static_dimension >::dimension_;
+
+        facets(size_type const _dimension,
+               allocator const & _allocator)
+            : quick_hull_dimension< static_dimension >(_dimension)
+            , points_(_allocator)
+            , vertices_(_allocator)
+            , neighbours_(_allocator)
+            , normals_(_allocator)
+            , D_(_allocator)
+            , outside_begins_(_allocator)
+            , outside_ends_(_allocator)
+            , coplanar_begins_(_allocator)
+            , coplanar_ends_(_allocator)
+            , coplanars_(_allocator)
+        { ; }
+
+        point_table points_; // all the points added (by point index), vertices and coplanar points of facets are referenced by their indices
+        point_indices vertices_;
+        facet_array neighbours_;
+        vector normals_;
+        vector D_;
+        facet_array outside_begins_;
+        facet_array outside_ends_;
+        facet_array coplanar_begins_;
+        facet_array coplanar_ends_;
+        point_indices coplanars_; // coplanar sets of all the facets are segments of the array
+
+        size_type
+        size() const
+        {
+            return D_.size();
+        }
+
+        size_type
+        capacity() const // strided arrays can be reserved for another dimension_ before reset()
+        {
+            return std::min({D_.capacity(), vertices_.capacity() / dimension_, neighbours_.capacity() / dimension_, normals_.capacity() / dimension_});
+        }
+
+        bool
+        empty() const
+        {
+            return D_.empty();
+        }
+
+        void
+        clear() // points_ are retained
+        {
+            vertices_.clear();
+            neighbours_.clear();
+            normals_.clear();
+            D_.clear();
+            outside_begins_.clear();
+            outside_ends_.clear();
+            coplanar_begins_.clear();
+            coplanar_ends_.clear();
+            coplanars_.clear();
+        }
+
+        void
+        reserve(size_type const _capacity) // no reallocation (and invalidation of views) happens until size() exceeds _capacity
+        {
+            vertices_.reserve(_capacity * dimension_);
+            neighbours_.reserve(_capacity * dimension_);
+            normals_.reserve(_capacity * dimension_);
+            D_.reserve(_capacity);
+            outside_begins_.reserve(_capacity);
+            outside_ends_.reserve(_capacity);
+            coplanar_begins_.reserve(_capacity);
+            coplanar_ends_.reserve(_capacity);
+        }
+
+        void
+        emplace_back()
+        {
+            vertices_.resize(vertices_.size() + dimension_);
+            neighbours_.resize(neighbours_.size() + dimension_);
+            normals_.resize(normals_.size() + dimension_);
+            D_.emplace_back();
+            outside_begins_.push_back(0);
+            outside_ends_.push_back(0);
+            coplanar_begins_.push_back(0);
+            coplanar_ends_.push_back(0);
+        }
+
+        void
+        pop_back()
+        {
+            vertices_.resize(vertices_.size() - dimension_);
+            neighbours_.resize(neighbours_.size() - dimension_);
+            normals_.resize(normals_.size() - dimension_);
+            D_.pop_back();
+            outside_begins_.pop_back();
+            outside_ends_.pop_back();
+            coplanar_begins_.pop_back();
+            coplanar_ends_.pop_back();
+        }
+
+        void
+        move(size_type const _source,
+             size_type const _destination)
+        {
+            std::copy_n(vertices(_source), dimension_, vertices(_destination));
+            std::copy_n(neighbours(_source), dimension_, neighbours(_destination));
+            std::copy_n(normal(_source), dimension_, normal(_destination));
+            D_[_destination] = D_[_source];
+            outside_begins_[_destination] = outside_begins_[_source];
+            outside_ends_[_destination] = outside_ends_[_source];
+            coplanar_begins_[_destination] = coplanar_begins_[_source];
+            coplanar_ends_[_destination] = coplanar_ends_[_source];
+        }
+
+        point_index * vertices(size_type const f) { return vertices_.data() + f * dimension_; }
+        point_index const * vertices(size_type const f) const { return vertices_.data() + f * dimension_; }
+        size_type * neighbours(size_type const f) { return neighbours_.data() + f * dimension_; }
+        size_type const * neighbours(size_type const f) const { return neighbours_.data() + f * dimension_; }
+        value_type * normal(size_type const f) { return normals_.data() + f * dimension_; }
+        value_type const * normal(size_type const f) const { return normals_.data() + f * dimension_; }
+
+        point_span
+        coplanar(size_type const f) const
+        {
+            return {&points_, coplanars_.data() + coplanar_begins_[f], coplanar_ends_[f] - coplanar_begins_[f]};
+        }
+
+        facet
+        operator [] (size_type const f)
+        {
+            return {{&points_, vertices(f), dimension_}, {neighbours(f), dimension_}, {normal(f), dimension_}, D_[f], outside_begins_[f], outside_ends_[f], coplanar(f)};
+        }
+
+        const_facet
+        operator [] (size_type const f) const
+        {
+            return {{&points_, vertices(f), dimension_}, {neighbours(f), dimension_}, {normal(f), dimension_}, D_[f], outside_begins_[f], outside_ends_[f], coplanar(f)};
+        }
+
+        facet front() { return operator [] (0); }
+        const_facet front() const { return operator [] (0); }
+        facet back() { return operator [] (size() - 1); }
+        const_facet back() const { return operator [] (size() - 1); }
+
+        template< typename arena, typename view >
+        struct basic_iterator // yields views
+        {
+
+            arena * facets_;
+            size_type f;
+
+            view operator * () const { return (*facets_)[f]; }
+            basic_iterator & operator ++ () { ++f; return *this; }
+            bool operator == (basic_iterator const & _rhs) const { return (f == _rhs.f); }
+            bool operator != (basic_iterator const & _rhs) const { return (f != _rhs.f); }
+
+        };
+
+        using iterator = basic_iterator< facets, facet >;
+        using const_iterator = basic_iterator< facets const, const_facet >;
+
+        iterator begin() { return {this, 0}; }
+        iterator end() { return {this, size()}; }
+        const_iterator begin() const { return {this, 0}; }
+        const_iterator end() const { return {this, size()}; }
+
+    };
 
     facets facets_;
 
     value_type
-    cos_of_dihedral_angle(facet const & _first, facet const & _second) const
+    cos_of_dihedral_angle(const_facet const & _first, const_facet const & _second) const
     {
         return std::inner_product(std::cbegin(_first.normal_), std::cend(_first.normal_), std::cbegin(_second.normal_), zero);
     }
@@ -140,66 +794,57 @@ public :
 private :
 
     void
-    make_facet(facet & _facet,
-               point_array const & _vertices,
+    make_facet(size_type const f,
+               point_index const * const _vertices,
                size_type const _against,
-               point_iterator const _apex,
+               point_index const _apex,
                size_type const _neighbour)
     {
-        assert(_vertices.size() == dimension_);
-        _facet.vertices_ = _vertices;
-        _facet.vertices_[_against] = _apex;
-        _facet.neighbours_.resize(dimension_);
-        _facet.neighbours_[_against] = _neighbour;
-        _facet.normal_.resize(dimension_);
+        point_index * const vertices_ = facets_.vertices(f);
+        std::copy_n(_vertices, dimension_, vertices_);
+        vertices_[_against] = _apex;
+        facets_.neighbours(f)[_against] = _neighbour;
     }
 
-    template< typename iterator >
     void
-    make_facet(facet & _facet,
-               iterator sbeg, // simplex
+    make_facet(size_type const f,
+               point_index const * const _simplex, // indices of (dimension_ + 1) vertices of the simplex
                size_type const _vertex,
                bool const _swap)
     {
-        using iterator_traits = std::iterator_traits< iterator >;
-        static_assert(std::is_base_of< std::input_iterator_tag, typename iterator_traits::iterator_category >::value);
-        static_assert(std::is_constructible< point_iterator, typename iterator_traits::value_type >::value);
-        _facet.vertices_.reserve(dimension_);
-        _facet.neighbours_.reserve(dimension_);
+        point_index * const vertices_ = facets_.vertices(f);
+        size_type * const neighbours_ = facets_.neighbours(f);
+        size_type i = 0;
         for (size_type v = 0; v <= dimension_; ++v) {
             if (v != _vertex) {
-                _facet.vertices_.push_back(*sbeg);
-                _facet.neighbours_.push_back(v);
+                vertices_[i] = _simplex[v];
+                neighbours_[i] = v;
+                ++i;
             }
-            ++sbeg;
         }
         if (_swap == (((dimension_ - _vertex) % 2) == 0)) {
             using std::swap;
-            swap(_facet.vertices_.front(), _facet.vertices_.back());
-            swap(_facet.neighbours_.front(), _facet.neighbours_.back());
+            swap(vertices_[0], vertices_[dimension_ - 1]);
+            swap(neighbours_[0], neighbours_[dimension_ - 1]);
         }
-        _facet.normal_.resize(dimension_);
     }
 
     void
-    reuse_facet(facet & _facet,
-                point_array const & _vertices,
-                size_type const _against,
-                point_iterator const _apex,
-                size_type const _neighbour)
+    copy_point(point_iterator const _from, vrow _to) const
+    {
+        std::copy_n(std::cbegin(*_from), dimension_, _to);
+    }
+
+    crow
+    coordinates(size_type const p) const
     {
-        assert(_vertices.size() == dimension_);
-        _facet.vertices_ = _vertices;
-        _facet.vertices_[_against] = _apex;
-        assert(_facet.neighbours_.size() == dimension_);
-        _facet.neighbours_[_against] = _neighbour;
-        assert(_facet.normal_.size() == dimension_);
+        return rows_ + p * rows_stride_;
     }
 
     void
-    copy_point(point_iterator const _from, vrow _to) const
+    copy_point(size_type const p, vrow _to) const
     {
-        std::copy_n(std::cbegin(*_from), dimension_, _to);
+        std::copy_n(coordinates(p), dimension_, _to);
     }
 
     void
@@ -252,13 +897,12 @@ private :
     }
 
     void
-    matrix_transpose_copy(point_array const & _vertices)
+    matrix_transpose_copy(point_index const * const _vertices)
     {
         for (size_type r = 0; r < dimension_; ++r) {
-            auto v = std::cbegin(*_vertices[r]);
+            crow const v = coordinates(_vertices[r]);
             for (size_type c = 0; c < dimension_; ++c) {
-                shadow_matrix_[c][r] = *v;
-                ++v;
+                shadow_matrix_[c][r] = v[c];
             }
         }
     }
@@ -301,6 +945,7 @@ private :
     det(matrix const & _matrix, size_type const _dimension) // hottest function (52% of runtime for D10)
     { // det_matrix_ contains lower unit triangular matrix and upper triangular at return
         assert(0 < _dimension);
+        QUICKHULL_STATISTICS_DO(++statistics_.det_calls_;)
         value_type det_ = one;
         std::copy_n(std::cbegin(_matrix), _dimension, std::begin(det_matrix_));
         for (size_type i = 0; i < _dimension; ++i) {
@@ -349,9 +994,9 @@ private :
     }
 
     void
-    set_hyperplane_equation(facet & _facet)
+    set_cofactor_hyperplane_equation(facet const & _facet) // complexity is O(d^4)
     {
-        matrix_transpose_copy(_facet.vertices_);
+        matrix_transpose_copy(_facet.vertices_.indices());
         matrix_restore();
         _facet.D = -det();
         value_type N = zero;
@@ -365,11 +1010,100 @@ private :
         N = sqrt(std::move(N));
         divide(_facet.normal_.data(), N);
         _facet.D /= std::move(N);
-        assert(_facet.distance(inner_point_) < zero);
     }
 
     bool
-    orthonormalize(point_list const & _affine_space,
+    solve_hyperplane_equation(facet const & _facet) // complexity is O(d^3)
+    { // normal is the last column of Q in QR decomposition of matrix of edges, outgoing from the first vertex
+        size_type const rank_ = dimension_ - 1;
+        vrow const origin_ = matrix_.front();
+        point_index const * vertex = _facet.vertices_.indices();
+        copy_point(*vertex, origin_);
+        for (size_type r = 0; r < rank_; ++r) { // affine space -> vector space
+            vrow const row_ = shadow_matrix_[r];
+            copy_point(*++vertex, row_);
+            subtract(row_, origin_);
+        }
+        if (!householder(rank_)) {
+            return false;
+        }
+        vrow const normal_ = _facet.normal_.data();
+        std::fill_n(normal_, rank_, zero);
+        normal_[rank_] = one;
+        size_type j = rank_;
+        while (0 < j) { // Q * e(rank_) is unit vector orthogonal to all the edges
+            --j;
+            crow const qrj_ = shadow_matrix_[j];
+            value_type s_ = zero;
+            for (size_type k = j; k < dimension_; ++k) {
+                s_ += qrj_[k] * normal_[k];
+            }
+            for (size_type k = j; k < dimension_; ++k) {
+                normal_[k] -= qrj_[k] * s_;
+            }
+        }
+        _facet.D = -std::inner_product(normal_, normal_ + dimension_, origin_, zero);
+        if (zero < _facet.distance(inner_point_)) { // orientation: inner point should lie on negative side
+            for (size_type k = 0; k < dimension_; ++k) {
+                normal_[k] = -normal_[k];
+            }
+            _facet.D = -_facet.D;
+        }
+        return true;
+    }
+
+    bool
+    set_closed_form_hyperplane_equation(facet const & _facet) // dimension_ is 2 or 3: normal is perpendicular to the edge or cross product of two edges
+    {
+        assert((dimension_ == 2) || (dimension_ == 3));
+        point_index const * const vertices_ = _facet.vertices_.indices();
+        crow const a = coordinates(vertices_[0]);
+        crow const b = coordinates(vertices_[1]);
+        vrow const normal_ = _facet.normal_.data();
+        if (dimension_ == 2) {
+            normal_[0] = b[1] - a[1];
+            normal_[1] = a[0] - b[0];
+        } else {
+            crow const c = coordinates(vertices_[2]);
+            value_type const u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            value_type const w[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+            normal_[0] = u[1] * w[2] - u[2] * w[1];
+            normal_[1] = u[2] * w[0] - u[0] * w[2];
+            normal_[2] = u[0] * w[1] - u[1] * w[0];
+        }
+        using std::sqrt;
+        value_type const N = sqrt(std::inner_product(normal_, normal_ + dimension_, normal_, zero));
+        if (!(eps < N)) {
+            return false;
+        }
+        divide(normal_, N);
+        _facet.D = -std::inner_product(normal_, normal_ + dimension_, a, zero);
+        if (zero < _facet.distance(inner_point_)) { // orientation: inner point should lie on negative side
+            for (size_type k = 0; k < dimension_; ++k) {
+                normal_[k] = -normal_[k];
+            }
+            _facet.D = -_facet.D;
+        }
+        return true;
+    }
+
+    void
+    set_hyperplane_equation(facet const & _facet)
+    {
+        QUICKHULL_STATISTICS_DO(++statistics_.hyperplane_equations_;)
+        bool degenerate_ = false;
+        if (cofactor_hyperplanes_ || !(((dimension_ == 2) || (dimension_ == 3)) ? set_closed_form_hyperplane_equation(_facet) : solve_hyperplane_equation(_facet))) {
+            degenerate_ = !cofactor_hyperplanes_; // vertices are affinely dependent within eps, e.g. apex lies on the line of horizon ridge
+            set_cofactor_hyperplane_equation(_facet);
+        }
+        if (inserting_ && (degenerate_ || !(_facet.distance(inner_point_) < zero))) {
+            misoriented_ = true; // only insert_points() can recover from degenerate configuration
+        }
+        assert(misoriented_ || (_facet.distance(inner_point_) < zero));
+    }
+
+    bool
+    orthonormalize(point_indices const & _affine_space,
                    size_type const _rank,
                    crow const _origin)
     {
@@ -382,10 +1116,17 @@ private :
             subtract(row_, _origin);
             ++vertex;
         }
-        for (size_type i = 0; i < _rank; ++i) { // Householder transformation
-            value_type sum_ = zero;
-            vrow const qri_ = shadow_matrix_[i];
-            for (size_type k = i; k < dimension_; ++k) {
+        return householder(_rank);
+    }
+
+    bool
+    householder(size_type const _rank) // QR decomposition of first _rank rows of shadow_matrix_
+    {
+        assert(!(dimension_ < _rank));
+        for (size_type i = 0; i < _rank; ++i) { // Householder transformation
+            value_type sum_ = zero;
+            vrow const qri_ = shadow_matrix_[i];
+            for (size_type k = i; k < dimension_; ++k) {
                 value_type const & qrik_ = qri_[k];
                 sum_ += qrik_ * qrik_;
             }
@@ -445,7 +1186,7 @@ private :
     }
 
     bool
-    steal_best(point_list & _basis)
+    steal_best(point_indices & _basis)
     { // set moves a point which is furthest from affine subspace formed by points of "_basis" set from "outside_" set to "_basis"
         assert(!_basis.empty());
         size_type const rank_ = _basis.size() - 1;
@@ -458,10 +1199,11 @@ private :
         forward_transformation(rank_);
         vrow const projection_ = shadow_matrix_.back();
         vrow const apex_ = shadow_matrix_.front();
-        value_type distance_ = zero; // square of distance to the subspace
-        auto const oend = std::cend(outside_);
+        value_type distance_ = eps * eps; // square of distance to the subspace: points closer then eps lie in the subspace
+        value_type const roundoff_ = ((zero < eps) ? value_type(4 * dimension_) * std::numeric_limits< value_type >::epsilon() : zero); // relative error of the projection: points closer then that lie in the subspace as well, unless eps is zero (exact input)
+        auto const oend = std::end(outside_);
         auto furthest = oend;
-        for (auto it = std::cbegin(outside_); it != oend; ++it) {
+        for (auto it = std::begin(outside_); it != oend; ++it) {
             copy_point(*it, apex_);
             subtract_and_assign(projection_, apex_, origin_); // turn translated space into vector space then project onto orthogonal subspace
             for (size_type i = 0; i < rank_; ++i) {
@@ -469,7 +1211,7 @@ private :
                 multiply_and_add(projection_, qi_, -std::inner_product(qi_, qi_ + dimension_, apex_, zero));
             }
             value_type d_ = std::inner_product(projection_, projection_ + dimension_, projection_, zero);
-            if (distance_ < d_) {
+            if ((distance_ < d_) && (roundoff_ * roundoff_ * std::inner_product(apex_, apex_ + dimension_, apex_, zero) < d_)) {
                 distance_ = std::move(d_);
                 furthest = it;
             }
@@ -477,90 +1219,487 @@ private :
         if (furthest == oend) {
             return false;
         }
-        _basis.splice(std::cend(_basis), outside_, furthest);
+        _basis.push_back(*furthest);
+        *furthest = outside_.back();
+        outside_.pop_back();
         return true;
     }
 
-    facet_array removed_facets_;
+    void
+    find_affine_basis(point_indices & _basis)
+    { // moves up to (dimension_ + 1) affinely independent points from outside_ to _basis
+        QUICKHULL_STATISTICS_DO(quick_hull_statistics::timer const timer_{statistics_.affine_basis_time_};)
+        assert(facets_.empty());
+        _basis.clear();
+        if (!outside_.empty()) {
+            _basis.push_back(outside_.front());
+            outside_.front() = outside_.back();
+            outside_.pop_back();
+            if (steal_best(_basis)) {
+                outside_.push_back(_basis.front()); // reject first point to rejudge it
+                _basis.erase(std::begin(_basis));
+                for (size_type i = 0; i < dimension_; ++i) {
+                    if (!steal_best(_basis)) {
+                        break; // can't find (i + 2) affinely independent points
+                    }
+                }
+            } // else can't find affinely independent second point
+        }
+    }
+
+    facet_array removed_facets_ = facet_array(allocator_);
+    bool inserting_ = false; // insert_points() is in progress: coplanar points of visible facets are partitioned anew, misoriented new facets cause the rebuild
+    bool misoriented_ = false; // inner point is not strictly below some new facet (e.g. apex coincides with a vertex within roundoff error), the cone of new facets is broken or it has a flat ridge
 
-    std::pair< facet &, size_type const >
-    add_facet(point_array const & _vertices,
+    size_type
+    add_facet(point_index const * const _vertices,
               size_type const _against,
-              point_iterator const _apex,
+              point_index const _apex,
               size_type const _neighbour)
     {
+        size_type f = facets_.size();
         if (removed_facets_.empty()) {
-            size_type const f = facets_.size();
+            assert(f < facets_.capacity()); // _vertices can point into facets_
             facets_.emplace_back();
-            facet & facet_ = facets_.back();
-            make_facet(facet_, _vertices, _against, _apex, _neighbour);
-            return {facet_, f};
+            QUICKHULL_STATISTICS_DO(statistics_.peak_facets_ = std::max(statistics_.peak_facets_, facets_.size());)
         } else {
-            size_type const f = removed_facets_.back();
+            f = removed_facets_.back();
             removed_facets_.pop_back();
-            facet & facet_ = facets_[f];
-            reuse_facet(facet_, _vertices, _against, _apex, _neighbour);
-            return {facet_, f};
+            QUICKHULL_STATISTICS_DO(++statistics_.removed_facets_reused_;)
         }
+        QUICKHULL_STATISTICS_DO(++statistics_.facets_added_;)
+        make_facet(f, _vertices, _against, _apex, _neighbour);
+        return f;
     }
 
-    using ranking = std::multimap< value_type, size_type >;
-    using ranking_meta = std::unordered_map< size_type, typename ranking::iterator >;
+    struct ranked_facet
+    {
+
+        value_type orientation_; // distance to the furthest point of outside set
+        size_type f;
+
+    };
+
+    static constexpr size_type unranked = ~size_type(0);
 
-    ranking ranking_;
-    ranking_meta ranking_meta_;
+    array< ranked_facet > ranking_ = array< ranked_facet >(allocator_); // indexed binary max-heap of facets with non-empty outside sets
+    facet_array ranking_meta_ = facet_array(allocator_); // position of each facet in the heap (or unranked)
+
+    void
+    place(ranked_facet && _ranked_facet, size_type const i)
+    {
+        ranking_meta_[_ranked_facet.f] = i;
+        ranking_[i] = std::move(_ranked_facet);
+    }
+
+    void
+    sift_up(size_type i)
+    {
+        ranked_facet ranked_facet_ = std::move(ranking_[i]);
+        while (0 < i) {
+            size_type const parent = (i - 1) / 2;
+            if (!(ranking_[parent].orientation_ < ranked_facet_.orientation_)) {
+                break;
+            }
+            place(std::move(ranking_[parent]), i);
+            i = parent;
+        }
+        place(std::move(ranked_facet_), i);
+    }
+
+    void
+    sift_down(size_type i)
+    {
+        size_type const size_ = ranking_.size();
+        ranked_facet ranked_facet_ = std::move(ranking_[i]);
+        for (;;) {
+            size_type child = 2 * i + 1;
+            if (!(child < size_)) {
+                break;
+            }
+            if ((child + 1 < size_) && (ranking_[child].orientation_ < ranking_[child + 1].orientation_)) {
+                ++child;
+            }
+            if (!(ranked_facet_.orientation_ < ranking_[child].orientation_)) {
+                break;
+            }
+            place(std::move(ranking_[child]), i);
+            i = child;
+        }
+        place(std::move(ranked_facet_), i);
+    }
 
     void
     rank(value_type && _orientation,
          size_type const f)
     {
         if (eps < _orientation) {
-            ranking_meta_.emplace(f, ranking_.emplace(std::move(_orientation), f));
+            if (!(f < ranking_meta_.size())) {
+                ranking_meta_.resize(facets_.size(), unranked);
+            }
+            assert(ranking_meta_[f] == unranked);
+            ranking_.push_back({std::move(_orientation), f});
+            sift_up(ranking_.size() - 1);
         }
     }
 
     void
     unrank(size_type const f)
     {
-        auto const r = ranking_meta_.find(f);
-        if (r != std::end(ranking_meta_)) {
-            ranking_.erase(r->second);
-            ranking_meta_.erase(r);
+        if (f < ranking_meta_.size()) {
+            size_type & r = ranking_meta_[f];
+            if (r != unranked) {
+                size_type const i = r;
+                r = unranked;
+                if (i + 1 != ranking_.size()) {
+                    place(std::move(ranking_.back()), i);
+                    ranking_.pop_back();
+                    if ((0 < i) && (ranking_[(i - 1) / 2].orientation_ < ranking_[i].orientation_)) {
+                        sift_up(i);
+                    } else {
+                        sift_down(i);
+                    }
+                } else {
+                    ranking_.pop_back();
+                }
+            }
         }
         removed_facets_.push_back(f);
     }
 
-    point_list outside_;
+    vector coordinates_ = vector(allocator_); // packed (row-major) copies of coordinates of stored points
+    crow rows_ = nullptr; // coordinates of p-th point are at rows_ + p * rows_stride_: either in coordinates_ or in the buffer of the caller
+    size_type rows_stride_ = 0;
+    point_indices simplex_indices_ = point_indices(allocator_);
+    point_indices outside_ = point_indices(allocator_); // points to be partitioned
+    point_indices outsides_ = point_indices(allocator_); // outside sets of all the facets are segments of the array
+    point_indices spare_outsides_ = point_indices(allocator_);
+    size_type dead_outsides_ = 0; // count of elements of outsides_, that do not belong to any segment
+    point_indices spare_coplanars_ = point_indices(allocator_);
+    size_type dead_coplanars_ = 0; // the same for facets_.coplanars_
+
+    static constexpr size_type batch_size = 256; // count of distances calculated at once
+
+    vector distances_ = vector(batch_size, allocator_);
+
+    void
+    signed_distances(const_facet const & _facet,
+                     point_index const * _points,
+                     size_type const _count,
+                     vrow const _distances) const
+    { // batched kernel: distances from the hyperplane to _count points with the indices specified
+        crow const normal_ = _facet.normal_.data();
+        crow const base_ = rows_;
+        size_type i = 0;
+#if defined(__AVX512F__)
+        if constexpr (std::is_same< value_type, double >::value) {
+            long long o_[8];
+            for (; i + 8 <= _count; i += 8) {
+                for (size_type k = 0; k < 8; ++k) {
+                    o_[k] = static_cast< long long >(size_type(_points[i + k]) * rows_stride_);
+                }
+                __m512i const offsets_ = _mm512_loadu_si512(o_);
+                __m512d distance_ = _mm512_set1_pd(_facet.D);
+                for (size_type j = 0; j < dimension_; ++j) {
+                    __m512d const x_ = _mm512_i64gather_pd(offsets_, base_ + j, sizeof(double));
+                    distance_ = _mm512_add_pd(distance_, _mm512_mul_pd(_mm512_set1_pd(normal_[j]), x_));
+                }
+                _mm512_storeu_pd(_distances + i, distance_);
+            }
+        }
+#endif
+#if defined(__AVX2__)
+        if constexpr (std::is_same< value_type, double >::value) {
+            for (; i + 4 <= _count; i += 4) {
+                __m256i const offsets_ = _mm256_set_epi64x(static_cast< long long >(size_type(_points[i + 3]) * rows_stride_),
+                                                           static_cast< long long >(size_type(_points[i + 2]) * rows_stride_),
+                                                           static_cast< long long >(size_type(_points[i + 1]) * rows_stride_),
+                                                           static_cast< long long >(size_type(_points[i + 0]) * rows_stride_));
+                __m256d distance_ = _mm256_set1_pd(_facet.D);
+                for (size_type j = 0; j < dimension_; ++j) {
+                    __m256d const x_ = _mm256_i64gather_pd(base_ + j, offsets_, sizeof(double));
+                    distance_ = _mm256_add_pd(distance_, _mm256_mul_pd(_mm256_set1_pd(normal_[j]), x_));
+                }
+                _mm256_storeu_pd(_distances + i, distance_);
+            }
+        } else if constexpr (std::is_same< value_type, float >::value) {
+            for (; i + 4 <= _count; i += 4) {
+                __m256i const offsets_ = _mm256_set_epi64x(static_cast< long long >(size_type(_points[i + 3]) * rows_stride_),
+                                                           static_cast< long long >(size_type(_points[i + 2]) * rows_stride_),
+                                                           static_cast< long long >(size_type(_points[i + 1]) * rows_stride_),
+                                                           static_cast< long long >(size_type(_points[i + 0]) * rows_stride_));
+                __m128 distance_ = _mm_set1_ps(_facet.D);
+                for (size_type j = 0; j < dimension_; ++j) {
+                    __m128 const x_ = _mm256_i64gather_ps(base_ + j, offsets_, sizeof(float));
+                    distance_ = _mm_add_ps(distance_, _mm_mul_ps(_mm_set1_ps(normal_[j]), x_));
+                }
+                _mm_storeu_ps(_distances + i, distance_);
+            }
+        }
+#endif
+        for (; i < _count; ++i) { // scalar fallback and remainder
+            crow const x_ = base_ + size_type(_points[i]) * rows_stride_;
+            _distances[i] = std::inner_product(normal_, normal_ + dimension_, x_, _facet.D);
+        }
+    }
 
     value_type
-    partition(facet & _facet)
-    {
+    partition(size_type const f)
+    { // streaming pass over outside_: points above the facet are appended to outsides_, others are retained
+        facet const facet_ = facets_[f];
+        point_indices & coplanars_ = facets_.coplanars_;
+        facets_.coplanar_begins_[f] = coplanars_.size();
+        size_type const outside_begin_ = outsides_.size();
+        size_type furthest = outside_begin_;
         value_type distance_ = zero;
-        auto it = std::cbegin(outside_);
-        auto const oend = std::cend(outside_);
-        while (it != oend) {
-            auto const next = std::next(it);
-            value_type d_ = _facet.distance(std::cbegin(**it));
-            if (eps < d_) {
-                if (distance_ < d_) {
-                    distance_ = std::move(d_);
-                    _facet.outside_.splice(std::cbegin(_facet.outside_), outside_, it);
+        size_type const size_ = outside_.size();
+        QUICKHULL_STATISTICS_DO(statistics_.partition_distances_ += size_;)
+        size_type retained = 0;
+        for (size_type b = 0; b < size_; b += batch_size) {
+            size_type const count_ = std::min(batch_size, size_ - b);
+            signed_distances(facet_, outside_.data() + b, count_, distances_.data());
+            for (size_type i = 0; i < count_; ++i) {
+                point_index const p = outside_[b + i];
+                value_type const & d_ = distances_[i];
+                if (eps < d_) {
+                    if (distance_ < d_) {
+                        distance_ = d_;
+                        furthest = outsides_.size();
+                    }
+                    outsides_.push_back(p);
                 } else {
-                    _facet.outside_.splice(std::cend(_facet.outside_), outside_, it);
+                    if (!(d_ < -eps)) {
+                        coplanars_.push_back(p);
+                    }
+                    outside_[retained] = p;
+                    ++retained;
                 }
-            } else if (!(d_ < -eps)) {
-                _facet.coplanar_.push_back(*it);
             }
-            it = next;
+        }
+        outside_.resize(retained);
+        facets_.coplanar_ends_[f] = coplanars_.size();
+        facet_.outside_begin_ = outside_begin_;
+        facet_.outside_end_ = outsides_.size();
+        if (furthest != outside_begin_) {
+            std::swap(outsides_[outside_begin_], outsides_[furthest]);
         }
         return distance_;
     }
 
+    static constexpr size_type chunk_size = 8192; // minimal count of points partitioned by single task
+
+    struct partition_chunk // results of partitioning of contiguous part of outside_ among new facets
+    {
+
+        point_indices outsides_; // outside sets of consecutive facets are consecutive segments
+        point_indices coplanars_;
+        facet_array outside_ends_;
+        facet_array coplanar_ends_;
+        facet_array furthest_; // position of the furthest point in outsides_ for each facet
+        vector orientations_; // distance to the furthest point for each facet
+        vector distances_;
+#if defined(QUICKHULL_STATISTICS)
+        quick_hull_statistics statistics_; // of the worker, which partitioned the chunk
+#endif
+
+        explicit
+        partition_chunk(allocator const & _allocator)
+            : outsides_(_allocator)
+            , coplanars_(_allocator)
+            , outside_ends_(_allocator)
+            , coplanar_ends_(_allocator)
+            , furthest_(_allocator)
+            , orientations_(_allocator)
+            , distances_(_allocator)
+        { ; }
+
+    };
+
+    array< partition_chunk > chunks_ = array< partition_chunk >(allocator_);
+
+    template< typename type >
+    void
+    grow(array< type > & _array,
+         size_type const _size) const // elements are constructed from allocator_
+    {
+        while (_array.size() < _size) {
+            _array.emplace_back(allocator_);
+        }
+    }
+
+    void
+    partition(partition_chunk & _chunk,
+              facet_array const & _facets,
+              point_index * const _points,
+              size_type _count)
+    { // the same as partition(f) for each facet in turn, but outside sets and coplanar points are collected in the chunk
+        _chunk.outsides_.clear();
+        _chunk.coplanars_.clear();
+        _chunk.outside_ends_.clear();
+        _chunk.coplanar_ends_.clear();
+        _chunk.furthest_.clear();
+        _chunk.orientations_.clear();
+        _chunk.distances_.resize(batch_size);
+        for (size_type const f : _facets) {
+            const_facet const facet_ = facets_[f];
+            QUICKHULL_STATISTICS_DO(_chunk.statistics_.partition_distances_ += _count;)
+            size_type furthest = _chunk.outsides_.size();
+            value_type distance_ = zero;
+            size_type retained = 0;
+            for (size_type b = 0; b < _count; b += batch_size) {
+                size_type const count_ = std::min(batch_size, _count - b);
+                signed_distances(facet_, _points + b, count_, _chunk.distances_.data());
+                for (size_type i = 0; i < count_; ++i) {
+                    point_index const p = _points[b + i];
+                    value_type const & d_ = _chunk.distances_[i];
+                    if (eps < d_) {
+                        if (distance_ < d_) {
+                            distance_ = d_;
+                            furthest = _chunk.outsides_.size();
+                        }
+                        _chunk.outsides_.push_back(p);
+                    } else {
+                        if (!(d_ < -eps)) {
+                            _chunk.coplanars_.push_back(p);
+                        }
+                        _points[retained] = p;
+                        ++retained;
+                    }
+                }
+            }
+            _count = retained;
+            _chunk.outside_ends_.push_back(_chunk.outsides_.size());
+            _chunk.coplanar_ends_.push_back(_chunk.coplanars_.size());
+            _chunk.furthest_.push_back(furthest);
+            _chunk.orientations_.push_back(distance_);
+        }
+    }
+
+    void
+    merge(facet_array const & _facets,
+          size_type const _first,
+          size_type const _count)
+    { // merge [_first; _first + _count) chunks in order: the result is the same as in serial case; rank the facets
+#if defined(QUICKHULL_STATISTICS)
+        for (size_type c = _first; c < _first + _count; ++c) {
+            statistics_ += chunks_[c].statistics_;
+            chunks_[c].statistics_ = {};
+        }
+#endif
+        for (size_type i = 0; i < _facets.size(); ++i) {
+            size_type const f = _facets[i];
+            facet const facet_ = facets_[f];
+            point_indices & coplanars_ = facets_.coplanars_;
+            facets_.coplanar_begins_[f] = coplanars_.size();
+            size_type const outside_begin_ = outsides_.size();
+            size_type furthest = outside_begin_;
+            value_type distance_ = zero;
+            for (size_type c = _first; c < _first + _count; ++c) {
+                partition_chunk const & chunk_ = chunks_[c];
+                size_type const obeg = ((i == 0) ? 0 : chunk_.outside_ends_[i - 1]);
+                if (distance_ < chunk_.orientations_[i]) {
+                    distance_ = chunk_.orientations_[i];
+                    furthest = outsides_.size() + (chunk_.furthest_[i] - obeg);
+                }
+                auto const outsides = std::cbegin(chunk_.outsides_);
+                outsides_.insert(std::cend(outsides_), std::next(outsides, std::ptrdiff_t(obeg)), std::next(outsides, std::ptrdiff_t(chunk_.outside_ends_[i])));
+                auto const coplanars = std::cbegin(chunk_.coplanars_);
+                coplanars_.insert(std::cend(coplanars_), std::next(coplanars, std::ptrdiff_t((i == 0) ? 0 : chunk_.coplanar_ends_[i - 1])), std::next(coplanars, std::ptrdiff_t(chunk_.coplanar_ends_[i])));
+            }
+            facets_.coplanar_ends_[f] = coplanars_.size();
+            facet_.outside_begin_ = outside_begin_;
+            facet_.outside_end_ = outsides_.size();
+            if (furthest != outside_begin_) {
+                std::swap(outsides_[outside_begin_], outsides_[furthest]);
+            }
+            rank(std::move(distance_), f);
+        }
+    }
+
+    size_type
+    split(size_type const _size) const // count of chunks to partition _size points in
+    {
+        if (!thread_pool_) {
+            return 1;
+        }
+        return std::max(std::min(_size / chunk_size, thread_pool_->size()), size_type(1));
+    }
+
+    void
+    partition(facet_array const & _facets)
+    { // partition outside_ among the facets and rank them, outside_ is empty at return
+        size_type const size_ = outside_.size();
+        size_type const chunks = split(size_);
+        if (chunks == 1) {
+            for (size_type const f : _facets) {
+                rank(partition(f), f);
+            }
+            outside_.clear();
+            return;
+        }
+        grow(chunks_, chunks);
+        thread_pool_->parallel_for(chunks, [&] (size_type const c, size_type)
+        {
+            size_type const begin_ = (size_ * c) / chunks;
+            partition(chunks_[c], _facets, outside_.data() + begin_, (size_ * (c + 1)) / chunks - begin_);
+        });
+        merge(_facets, 0, chunks);
+        outside_.clear();
+    }
+
+    void
+    compactify_segments()
+    { // gather alive segments of outsides_ and coplanar sets together
+        spare_outsides_.clear();
+        spare_coplanars_.clear();
+        point_indices & coplanars_ = facets_.coplanars_;
+        for (size_type f = 0; f < facets_.size(); ++f) {
+            {
+                size_type & outside_begin_ = facets_.outside_begins_[f];
+                size_type & outside_end_ = facets_.outside_ends_[f];
+                auto const obeg = std::next(std::cbegin(outsides_), std::ptrdiff_t(outside_begin_));
+                auto const oend = std::next(std::cbegin(outsides_), std::ptrdiff_t(outside_end_));
+                outside_begin_ = spare_outsides_.size();
+                spare_outsides_.insert(std::cend(spare_outsides_), obeg, oend);
+                outside_end_ = spare_outsides_.size();
+            }
+            {
+                size_type & coplanar_begin_ = facets_.coplanar_begins_[f];
+                size_type & coplanar_end_ = facets_.coplanar_ends_[f];
+                auto const cbeg = std::next(std::cbegin(coplanars_), std::ptrdiff_t(coplanar_begin_));
+                auto const cend = std::next(std::cbegin(coplanars_), std::ptrdiff_t(coplanar_end_));
+                coplanar_begin_ = spare_coplanars_.size();
+                spare_coplanars_.insert(std::cend(spare_coplanars_), cbeg, cend);
+                coplanar_end_ = spare_coplanars_.size();
+            }
+        }
+        outsides_.swap(spare_outsides_);
+        coplanars_.swap(spare_coplanars_);
+        dead_outsides_ = 0;
+        dead_coplanars_ = 0;
+    }
+
     size_type
     get_best_facet() const
     {
-        assert(ranking_meta_.size() == ranking_.size());
-        return std::prev(std::cend(ranking_))->second;
+        assert(!ranking_.empty());
+        return ranking_.front().f;
+    }
+
+    ranked_facet
+    pop_best_facet()
+    {
+        assert(!ranking_.empty());
+        ranked_facet best_ = std::move(ranking_.front());
+        ranking_meta_[best_.f] = unranked;
+        if (1 < ranking_.size()) {
+            place(std::move(ranking_.back()), 0);
+            ranking_.pop_back();
+            sift_down(0);
+        } else {
+            ranking_.pop_back();
+        }
+        return best_;
     }
 
     void
@@ -569,7 +1708,9 @@ private :
                       size_type const _to)
     {
         if (_from != _to) {
-            for (size_type & n : facets_[f].neighbours_) {
+            size_type * const neighbours_ = facets_.neighbours(f);
+            for (size_type v = 0; v < dimension_; ++v) {
+                size_type & n = neighbours_[v];
                 if (n == _from) {
                     n = _to;
                     return;
@@ -578,169 +1719,942 @@ private :
         }
     }
 
-    struct ridge
+    struct ridge // entry of open addressing hash table of ridges of new facets, which are waiting for adjacent facet
     {
 
-        facet & facet_;
-        size_type const f;
-        size_type const v;
-        size_type const hash_;
+        static constexpr size_type matched = std::numeric_limits< size_type >::max();
 
-        bool
-        operator == (ridge const & _rhs) const noexcept
-        {
-            point_iterator const lskip = facet_.vertices_[v];
-            point_iterator const rskip = _rhs.facet_.vertices_[_rhs.v];
-            for (point_iterator const & l : facet_.vertices_) {
-                if (l != lskip) {
-                    bool found_ = false;
-                    for (point_iterator const & r : _rhs.facet_.vertices_) {
-                        if (r != rskip) {
-                            if (l == r) {
-                                found_ = true; // O(D^2) expensive
-                                break;
-                            }
-                        }
+        std::uint64_t hash_;
+        size_type f;
+        size_type v; // the ridge is facet f without vertex v, or matched (the entry is not vacant to keep probe sequences unbroken)
+        size_type generation_; // the entry is vacant, if less then ridges_generation_
+
+    };
+
+    array< ridge > ridges_ = array< ridge >(allocator_); // linear probing, size is a power of two
+    point_indices ridges_keys_ = point_indices(allocator_); // canonical key of each entry: sorted indices of (dimension_ - 1) vertices of the ridge
+    size_type ridges_generation_ = 0;
+    size_type pending_ridges_ = 0; // count of ridges without adjacent facet
+    dimension_array< std::uint64_t > vertices_hashes_ = make_array< std::uint64_t >();
+    dimension_array< point_index > sorted_vertices_ = make_array< point_index >();
+    dimension_array< point_index > ridge_key_ = make_array< point_index >();
+
+    static
+    std::uint64_t
+    point_hash(point_index const p) noexcept
+    { // splitmix64 finalizer: hashes of ridges are sums of hashes of vertices, therefore they do not depend on order of vertices
+        std::uint64_t h = std::uint64_t(p) + 0x9E3779B97F4A7C15u;
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9u;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBu;
+        return (h ^ (h >> 31));
+    }
+
+    void
+    prepare_ridges(size_type const _count) // clear the table and make it large enough for ridges of _count new facets
+    {
+        size_type const ridges_count_ = _count * (dimension_ - 1);
+        size_type size_ = std::max(ridges_.size(), size_type(16));
+        while (size_ < 2 * ridges_count_) {
+            size_ *= 2;
+        }
+        if ((ridges_.size() < size_) || (ridges_keys_.size() != size_ * (dimension_ - 1))) { // grown or dimension_ changed by reset()
+            ridges_.assign(size_, {0, 0, 0, 0});
+            ridges_keys_.resize(size_ * (dimension_ - 1));
+            ridges_generation_ = 0;
+        }
+        ++ridges_generation_;
+        assert(pending_ridges_ == 0);
+    }
+
+    void
+    find_adjacent_facets(size_type const f,
+                         size_type const _skip)
+    {
+        size_type const rank_ = dimension_ - 1;
+        point_index const * const vertices_ = facets_.vertices(f);
+        std::copy_n(vertices_, dimension_, std::begin(sorted_vertices_));
+        std::sort(std::begin(sorted_vertices_), std::begin(sorted_vertices_) + std::ptrdiff_t(dimension_));
+        std::uint64_t facet_hash_ = 0;
+        for (size_type v = 0; v < dimension_; ++v) {
+            facet_hash_ += (vertices_hashes_[v] = point_hash(vertices_[v]));
+        }
+        size_type const mask_ = ridges_.size() - 1;
+        for (size_type v = 0; v < dimension_; ++v) {
+            if (v != _skip) { // neighbouring facet against apex (_skip-indexed) is known atm
+                std::uint64_t const ridge_hash_ = facet_hash_ - vertices_hashes_[v];
+                std::remove_copy(std::cbegin(sorted_vertices_), std::cbegin(sorted_vertices_) + std::ptrdiff_t(dimension_), std::begin(ridge_key_), vertices_[v]);
+                QUICKHULL_STATISTICS_DO(++statistics_.ridge_lookups_;)
+                QUICKHULL_STATISTICS_DO(size_type probes_ = 0;)
+                for (size_type r = size_type(ridge_hash_) & mask_; ; r = (r + 1) & mask_) {
+                    QUICKHULL_STATISTICS_DO(++statistics_.ridge_probes_;)
+                    QUICKHULL_STATISTICS_DO(statistics_.max_ridge_probes_ = std::max(statistics_.max_ridge_probes_, ++probes_);)
+                    ridge & ridge_ = ridges_[r];
+                    point_index * const key_ = ridges_keys_.data() + r * rank_;
+                    if (ridge_.generation_ != ridges_generation_) { // vacant
+                        ridge_ = {ridge_hash_, f, v, ridges_generation_};
+                        std::copy_n(std::cbegin(ridge_key_), rank_, key_);
+                        ++pending_ridges_;
+                        break;
                     }
-                    if (!found_) {
-                        return false;
+                    if ((ridge_.v != ridge::matched) && (ridge_.hash_ == ridge_hash_) && std::equal(key_, key_ + rank_, std::cbegin(ridge_key_))) { // ridge of degenerate horizon can be shared by more than two new facets, they are paired in order
+                        facets_.neighbours(ridge_.f)[ridge_.v] = f;
+                        facets_.neighbours(f)[v] = ridge_.f;
+                        ridge_.v = ridge::matched;
+                        --pending_ridges_;
+                        break;
                     }
                 }
             }
-            return true;
         }
+    }
+
+    struct visitation // marks of facets visited during traversal, one instance per thread
+    {
+
+        facet_array visited_; // visited_[f] is epoch_ if facet f is visited and invisible, (epoch_ + 1) if visible, less if not visited yet
+        size_type epoch_ = 0;
+        facet_array plateau_; // queue of facets during traversal of a plateau by locate()
+
+        explicit
+        visitation(allocator const & _allocator)
+            : visited_(_allocator)
+            , plateau_(_allocator)
+        { ; }
 
     };
 
-    struct ridge_hash
+    visitation visitation_ = visitation(allocator_);
+
+    void
+    next_epoch(visitation & _visitation) const
+    {
+        if (_visitation.visited_.size() < facets_.size()) {
+            _visitation.visited_.resize(facets_.size(), 0);
+        }
+        _visitation.epoch_ += 2;
+    }
+
+    struct horizon_ridge
     {
 
-        size_type
-        operator () (ridge const & _ridge) const noexcept
+        size_type f; // visible facet
+        size_type v; // vertex of visible facet, which is opposite to the ridge
+        size_type n; // invisible neighbouring facet, which lies against the vertex
+
+    };
+
+    struct horizon
+    {
+
+        facet_array visibles_; // visible facets in order of traversal, serves as a queue during traversal
+        array< horizon_ridge > ridges_;
+
+        explicit
+        horizon(allocator const & _allocator)
+            : visibles_(_allocator)
+            , ridges_(_allocator)
+        { ; }
+
+    };
+
+    facet_array newfacets_ = facet_array(allocator_); // facets to partition outside_ among
+    horizon horizon_ = horizon(allocator_);
+
+    void
+    find_horizon(visitation & _visitation,
+                 horizon & _horizon,
+                 size_type const f,
+                 size_type const _apex) const // traverse the graph of visible facets breadth-first
+    {
+        facet_array & visibles_ = _horizon.visibles_;
+        assert(visibles_.empty());
+        assert(_horizon.ridges_.empty());
+        next_epoch(_visitation);
+        facet_array & visited_ = _visitation.visited_;
+        size_type const epoch_ = _visitation.epoch_;
+        crow const apex_ = coordinates(_apex);
+        assert(zero < facets_[f].distance(apex_));
+        visited_[f] = epoch_ + 1;
+        visibles_.push_back(f);
+        for (size_type i = 0; i < visibles_.size(); ++i) {
+            size_type const visible = visibles_[i];
+            size_type const * const neighbours_ = facets_.neighbours(visible);
+            for (size_type v = 0; v < dimension_; ++v) {
+                size_type const neighbour = neighbours_[v];
+                assert(neighbour < visited_.size());
+                size_type & mark_ = visited_[neighbour];
+                if (mark_ < epoch_) {
+                    if (zero < facets_[neighbour].distance(apex_)) {
+                        mark_ = epoch_ + 1;
+                        visibles_.push_back(neighbour);
+                        continue;
+                    }
+                    mark_ = epoch_;
+                } else if (mark_ != epoch_) {
+                    continue; // visible
+                }
+                _horizon.ridges_.push_back({visible, v, neighbour});
+            }
+        }
+    }
+
+    value_type
+    gauge(size_type const f,
+          crow const x) const // gauge function of the hull centered at inner point, as it is on the cone of f-th facet
+    {
+        const_facet const facet_ = facets_[f];
+        return facet_.distance(x) / -facet_.distance(inner_point_);
+    }
+
+    size_type
+    locate(visitation & _visitation,
+           size_type f,
+           point_index const _point) const // hill climbing on gauge function of the hull centered at inner point
+    { // maximum of (distance to facet / distance from inner point to facet) is attained on the facet, whose cone (from inner point) contains the point;
+      // the function is linear on vertices of the polar polytope, which are adjacent if the facets are, so every local maximum is global one up to plateaus of coplanar facets
+        next_epoch(_visitation);
+        facet_array & visited_ = _visitation.visited_;
+        facet_array & plateau_ = _visitation.plateau_;
+        size_type const epoch_ = _visitation.epoch_;
+        crow const x = coordinates(_point);
+        value_type roundoff_ = zero; // coplanar facets of the plateau have distinct hyperplane equations: their gauges differ by the order of machine epsilon times the magnitude of coordinates
+        {
+            using std::abs;
+            for (size_type i = 0; i < dimension_; ++i) {
+                roundoff_ += abs(x[i]) + abs(inner_point_[i]);
+            }
+            roundoff_ *= value_type(4 * dimension_) * std::numeric_limits< value_type >::epsilon();
+        }
+        value_type gauge_ = gauge(f, x);
+        for (;;) {
+            for (;;) { // steepest ascent
+                size_type const * const neighbours_ = facets_.neighbours(f);
+                size_type next = f;
+                value_type next_gauge_ = gauge_;
+                for (size_type v = 0; v < dimension_; ++v) {
+                    size_type const neighbour = neighbours_[v];
+                    value_type g = gauge(neighbour, x);
+                    if (next_gauge_ < g) {
+                        next_gauge_ = std::move(g);
+                        next = neighbour;
+                    }
+                }
+                if (next == f) {
+                    break;
+                }
+                f = next;
+                gauge_ = std::move(next_gauge_);
+            }
+            value_type const tolerance_ = (eps + roundoff_ * (one + std::max(gauge_, zero))) / -facets_[f].distance(inner_point_);
+            plateau_.clear(); // breadth-first traversal of the facets, which are not lower then the local maximum
+            plateau_.push_back(f);
+            visited_[f] = epoch_;
+            size_type const top = f;
+            for (size_type i = 0; (f == top) && (i < plateau_.size()); ++i) {
+                size_type const * const neighbours_ = facets_.neighbours(plateau_[i]);
+                for (size_type v = 0; v < dimension_; ++v) {
+                    size_type const neighbour = neighbours_[v];
+                    if (visited_[neighbour] == epoch_) {
+                        continue;
+                    }
+                    visited_[neighbour] = epoch_;
+                    value_type g = gauge(neighbour, x);
+                    if (gauge_ + tolerance_ < g) {
+                        f = neighbour;
+                        gauge_ = std::move(g);
+                        break; // ascent continues
+                    }
+                    if (!(g < gauge_ - tolerance_)) {
+                        plateau_.push_back(neighbour);
+                    }
+                }
+            }
+            if (f == top) {
+                return f;
+            }
+        }
+    }
+
+    void
+    process_visibles(horizon & _horizon,
+                     facet_array & _newfacets,
+                     point_indices & _orphans,
+                     point_index const _apex) // replace visible facets by cone of new facets, which is built upon the horizon
+    {
+        for (size_type const f : _horizon.visibles_) {
+            facet const facet_ = facets_[f];
+            auto const obeg = std::next(std::cbegin(outsides_), std::ptrdiff_t(facet_.outside_begin_));
+            auto const oend = std::next(std::cbegin(outsides_), std::ptrdiff_t(facet_.outside_end_));
+            _orphans.insert(std::cend(_orphans), obeg, oend);
+            dead_outsides_ += (facet_.outside_end_ - facet_.outside_begin_);
+            facet_.outside_begin_ = facet_.outside_end_;
+            if (inserting_) { // points of the former hull, which lie on visible facets (horizon ridges included), become coplanar points of new facets
+                auto const cbeg = std::next(std::cbegin(facets_.coplanars_), std::ptrdiff_t(facets_.coplanar_begins_[f]));
+                auto const cend = std::next(std::cbegin(facets_.coplanars_), std::ptrdiff_t(facets_.coplanar_ends_[f]));
+                _orphans.insert(std::cend(_orphans), cbeg, cend);
+            }
+            dead_coplanars_ += (facets_.coplanar_ends_[f] - facets_.coplanar_begins_[f]);
+            facets_.coplanar_begins_[f] = facets_.coplanar_ends_[f];
+        }
+        size_type const capacity_ = facets_.size() + _horizon.ridges_.size();
+        if (facets_.capacity() < capacity_) {
+            facets_.reserve(std::max(capacity_, 2 * facets_.capacity()));
+        }
+        prepare_ridges(_horizon.ridges_.size());
+        for (horizon_ridge const & horizon_ridge_ : _horizon.ridges_) {
+            size_type const newfacet = add_facet(facets_.vertices(horizon_ridge_.f), horizon_ridge_.v, _apex, horizon_ridge_.n);
+            set_hyperplane_equation(facets_[newfacet]);
+            _newfacets.push_back(newfacet);
+            replace_neighbour(horizon_ridge_.n, horizon_ridge_.f, newfacet);
+            find_adjacent_facets(newfacet, horizon_ridge_.v);
+        }
+        for (size_type const f : _horizon.visibles_) {
+            unrank(f);
+        }
+        _horizon.visibles_.clear();
+        _horizon.ridges_.clear();
+    }
+
+    void
+    process_apex()
+    {
+        size_type const f = get_best_facet();
+        facet const best_ = facets_[f];
+        assert(best_.outside_begin_ < best_.outside_end_);
+        point_index const apex = outsides_[best_.outside_begin_++];
+        ++dead_outsides_;
+        {
+            QUICKHULL_STATISTICS_DO(quick_hull_statistics::timer const timer_{statistics_.horizon_time_};)
+            find_horizon(visitation_, horizon_, f, apex);
+        }
+        QUICKHULL_STATISTICS_DO(statistics_.visit_apex(horizon_.visibles_.size(), horizon_.ridges_.size());)
         {
-            return _ridge.hash_;
+            QUICKHULL_STATISTICS_DO(quick_hull_statistics::timer const timer_{statistics_.cone_time_};)
+            process_visibles(horizon_, newfacets_, outside_, apex);
         }
+        check_cone(newfacets_);
+        {
+            QUICKHULL_STATISTICS_DO(quick_hull_statistics::timer const timer_{statistics_.partition_time_};)
+            partition(newfacets_);
+        }
+        newfacets_.clear();
+    }
+
+    struct apex_candidate
+    {
+
+        value_type orientation_;
+        size_type f; // facet, which the apex is taken from
+        point_index apex;
+        horizon horizon_;
+        facet_array newfacets_;
+        point_indices orphans_;
+        size_type chunk_; // orphans_ are partitioned in chunks_[chunk_; chunk_ + chunks_count_)
+        size_type chunks_count_;
+
+        explicit
+        apex_candidate(allocator const & _allocator)
+            : horizon_(_allocator)
+            , newfacets_(_allocator)
+            , orphans_(_allocator)
+        { ; }
 
     };
 
-    std::unordered_set< ridge, ridge_hash > unique_ridges_;
-    std::hash< typename std::iterator_traits< point_iterator >::value_type const * > point_hash_;
-    std::vector< size_type > vertices_hashes_;
+    array< apex_candidate > candidates_ = array< apex_candidate >(allocator_);
+    array< visitation > visitations_ = array< visitation >(allocator_); // per worker
+    facet_array claimed_ = facet_array(allocator_); // claimed_[f] is round_ if facet f is visible from or adjacent to visible region of accepted apex
+    size_type round_ = 0;
+    facet_array owners_ = facet_array(allocator_); // candidate for each of chunks_
 
     void
-    find_adjacent_facets(facet & _facet,
-                         size_type const f,
-                         size_type const _skip)
+    process_apexes()
+    { // several apexes with disjoint visible regions are processed per round
+        QUICKHULL_STATISTICS_DO(quick_hull_statistics::stopwatch stopwatch_;)
+        size_type const count_ = std::min(concurrent_apexes_, ranking_.size());
+        grow(candidates_, count_);
+        for (size_type c = 0; c < count_; ++c) {
+            apex_candidate & candidate_ = candidates_[c];
+            ranked_facet best_ = pop_best_facet();
+            facet const facet_ = facets_[best_.f];
+            assert(facet_.outside_begin_ < facet_.outside_end_);
+            candidate_.orientation_ = std::move(best_.orientation_);
+            candidate_.f = best_.f;
+            candidate_.apex = outsides_[facet_.outside_begin_++];
+        }
+        grow(visitations_, thread_pool_->size());
+        thread_pool_->parallel_for(count_, [&] (size_type const c, size_type const w)
+        {
+            apex_candidate & candidate_ = candidates_[c];
+            find_horizon(visitations_[w], candidate_.horizon_, candidate_.f, candidate_.apex);
+        });
+        // visible region of an apex remains the same after processing of another apex,
+        // if it does not intersect visible region of the latter and its horizon neighbours
+        if (claimed_.size() < facets_.size()) {
+            claimed_.resize(facets_.size(), 0);
+        }
+        ++round_;
+        size_type accepted = 0;
+        for (size_type c = 0; c < count_; ++c) {
+            apex_candidate & candidate_ = candidates_[c];
+            horizon & apex_horizon_ = candidate_.horizon_;
+            bool disjoint_ = true;
+            for (size_type const f : apex_horizon_.visibles_) {
+                if (claimed_[f] == round_) {
+                    disjoint_ = false;
+                    break;
+                }
+            }
+            if (disjoint_) {
+                for (size_type const f : apex_horizon_.visibles_) {
+                    claimed_[f] = round_;
+                }
+                for (horizon_ridge const & horizon_ridge_ : apex_horizon_.ridges_) {
+                    claimed_[horizon_ridge_.n] = round_;
+                }
+                if (accepted != c) {
+                    std::swap(candidates_[accepted], candidate_);
+                }
+                ++accepted;
+            } else { // retry in the next round
+                --facets_[candidate_.f].outside_begin_;
+                rank(std::move(candidate_.orientation_), candidate_.f);
+                apex_horizon_.visibles_.clear();
+                apex_horizon_.ridges_.clear();
+            }
+        }
+        assert(0 < accepted); // the best apex is always accepted
+        QUICKHULL_STATISTICS_DO(statistics_.horizon_time_ += stopwatch_.lap();)
+        size_type chunks = 0;
+        owners_.clear();
+        for (size_type c = 0; c < accepted; ++c) {
+            apex_candidate & candidate_ = candidates_[c];
+            ++dead_outsides_;
+            QUICKHULL_STATISTICS_DO(statistics_.visit_apex(candidate_.horizon_.visibles_.size(), candidate_.horizon_.ridges_.size());)
+            process_visibles(candidate_.horizon_, candidate_.newfacets_, candidate_.orphans_, candidate_.apex);
+            check_cone(candidate_.newfacets_);
+            candidate_.chunk_ = chunks;
+            candidate_.chunks_count_ = split(candidate_.orphans_.size());
+            chunks += candidate_.chunks_count_;
+            owners_.resize(chunks, c);
+        }
+        QUICKHULL_STATISTICS_DO(statistics_.cone_time_ += stopwatch_.lap();)
+        grow(chunks_, chunks);
+        thread_pool_->parallel_for(chunks, [&] (size_type const t, size_type)
+        {
+            apex_candidate & candidate_ = candidates_[owners_[t]];
+            size_type const size_ = candidate_.orphans_.size();
+            size_type const c = t - candidate_.chunk_;
+            size_type const begin_ = (size_ * c) / candidate_.chunks_count_;
+            size_type const end_ = (size_ * (c + 1)) / candidate_.chunks_count_;
+            partition(chunks_[t], candidate_.newfacets_, candidate_.orphans_.data() + begin_, end_ - begin_);
+        });
+        for (size_type c = 0; c < accepted; ++c) {
+            apex_candidate & candidate_ = candidates_[c];
+            merge(candidate_.newfacets_, candidate_.chunk_, candidate_.chunks_count_);
+            candidate_.newfacets_.clear();
+            candidate_.orphans_.clear();
+        }
+        QUICKHULL_STATISTICS_DO(statistics_.partition_time_ += stopwatch_.lap();)
+    }
+
+    void
+    compactify()
     {
-        size_type ridge_hash_ = 0;
-        for (size_type v = 0; v < dimension_; ++v) {
-            if (v != _skip) {
-                ridge_hash_ ^= (vertices_hashes_[v] = point_hash_(std::addressof(*_facet.vertices_[v])));
+        size_type source = facets_.size();
+        assert(removed_facets_.size() < source);
+        assert(dimension_ < source - removed_facets_.size());
+        assert(!(source < ranking_.size()));
+        std::sort(std::rbegin(removed_facets_), std::rend(removed_facets_));
+        for (size_type const destination : removed_facets_) {
+            assert(!(source < destination));
+            if (destination != --source) {
+                facets_.move(source, destination);
+                size_type const * const neighbours_ = facets_.neighbours(destination);
+                for (size_type v = 0; v < dimension_; ++v) {
+                    replace_neighbour(neighbours_[v], source, destination);
+                }
+                if (source < ranking_meta_.size()) {
+                    size_type & r = ranking_meta_[source];
+                    if (r != unranked) {
+                        ranking_[r].f = destination;
+                        ranking_meta_[destination] = r;
+                        r = unranked;
+                    }
+                }
             }
+            facets_.pop_back();
         }
-        for (size_type v = 0; v < dimension_; ++v) {
-            if (v != _skip) { // neighbouring facet against apex (_skip-indexed) is known atm
-                auto const position = unique_ridges_.insert({_facet, f, v, (ridge_hash_ ^ vertices_hashes_[v])});
-                if (!position.second) {
-                    ridge const & ridge_ = *position.first;
-                    ridge_.facet_.neighbours_[ridge_.v] = f;
-                    _facet.neighbours_[v] = ridge_.f;
-                    unique_ridges_.erase(position.first);
+        removed_facets_.clear();
+        if (facets_.size() < ranking_meta_.size()) {
+            ranking_meta_.resize(facets_.size());
+        }
+    }
+
+    void
+    process_ranking()
+    { // process apexes until all the outside sets are empty
+        while (!ranking_.empty()) {
+            if (thread_pool_ && (1 < concurrent_apexes_)) {
+                process_apexes();
+            } else {
+                process_apex();
+            }
+            if ((outsides_.size() < dead_outsides_ * 2) || (facets_.coplanars_.size() < dead_coplanars_ * 2)) {
+                QUICKHULL_STATISTICS_DO(quick_hull_statistics::timer const timer_{statistics_.compactify_time_};)
+                compactify_segments();
+            }
+            if (misoriented_) {
+                return; // insert_points() rebuilds the hull
+            }
+            //assert((compactify(), check()));
+        }
+        assert(ranking_.empty());
+        QUICKHULL_STATISTICS_DO(quick_hull_statistics::timer const timer_{statistics_.compactify_time_};)
+        compactify();
+        compactify_segments();
+        assert(outsides_.empty());
+    }
+
+    facet_array located_ = facet_array(allocator_); // facet found for each point of outside_
+    array< std::pair< size_type, point_index > > placements_ = array< std::pair< size_type, point_index > >(allocator_);
+
+    // Mucke, E. P., Saias, I., Zhu, B., 1996. "Fast randomized point location without preprocessing in two- and three-dimensional Delaunay triangulations", SCG '96.
+    void
+    locate_outside()
+    { // points of outside_ are placed into outside sets or coplanar sets of the facets of ready convex hull, the facets are ranked, outside_ is empty at return
+        size_type const size_ = outside_.size();
+        located_.resize(size_);
+        size_type const chunks = split(size_);
+        size_type const facets_count_ = facets_.size(); // there are no removed facets
+        using std::pow;
+        size_type const samples_ = size_type(pow(value_type(facets_count_), one / value_type(dimension_))); // the walk is about (facets count / samples count)^(1 / (dimension - 1)) facets long
+        auto const locate_chunk = [&] (size_type const c, size_type const w)
+        {
+            visitation & marks_ = ((chunks == 1) ? visitation_ : visitations_[w]);
+            size_type f = 0; // the facet found for the previous point is a good starting facet for spatially coherent input
+            for (size_type i = (size_ * c) / chunks; i < (size_ * (c + 1)) / chunks; ++i) {
+                crow const x = coordinates(outside_[i]);
+                value_type gauge_ = gauge(f, x);
+                for (size_type s = 0; s < samples_; ++s) { // jump: the walk starts from the highest of evenly spaced facets
+                    size_type const g = (s * facets_count_) / samples_;
+                    value_type gauge_g_ = gauge(g, x);
+                    if (gauge_ < gauge_g_) {
+                        gauge_ = std::move(gauge_g_);
+                        f = g;
+                    }
                 }
+                f = locate(marks_, f, outside_[i]);
+                located_[i] = f;
             }
+        };
+        if (chunks == 1) {
+            locate_chunk(0, 0);
+        } else {
+            grow(visitations_, thread_pool_->size());
+            thread_pool_->parallel_for(chunks, locate_chunk);
+        }
+        placements_.clear();
+        for (size_type i = 0; i < size_; ++i) {
+            point_index const p = outside_[i];
+            size_type const f = located_[i];
+            if (!(facets_[f].distance(coordinates(p)) < -eps)) {
+                placements_.emplace_back(f, p);
+            } // else point is inside of the hull
+        }
+        outside_.clear();
+        std::sort(std::begin(placements_), std::end(placements_));
+        point_indices & coplanars_ = facets_.coplanars_;
+        auto placement_ = std::cbegin(placements_);
+        auto const pend = std::cend(placements_);
+        while (placement_ != pend) {
+            size_type const f = placement_->first;
+            facet const facet_ = facets_[f];
+            assert(!(facet_.outside_begin_ < facet_.outside_end_));
+            size_type const coplanar_begin_ = facets_.coplanar_begins_[f];
+            size_type const coplanar_end_ = facets_.coplanar_ends_[f];
+            if (coplanar_end_ != coplanars_.size()) { // coplanar set is moved to the end of coplanars_ to be extended
+                dead_coplanars_ += (coplanar_end_ - coplanar_begin_);
+                facets_.coplanar_begins_[f] = coplanars_.size();
+                for (size_type i = coplanar_begin_; i < coplanar_end_; ++i) {
+                    coplanars_.push_back(coplanars_[i]);
+                }
+            }
+            size_type const outside_begin_ = outsides_.size();
+            size_type furthest = outside_begin_;
+            value_type distance_ = zero;
+            for (; (placement_ != pend) && (placement_->first == f); ++placement_) {
+                point_index const p = placement_->second;
+                value_type d_ = facet_.distance(coordinates(p));
+                if (eps < d_) {
+                    if (distance_ < d_) {
+                        distance_ = std::move(d_);
+                        furthest = outsides_.size();
+                    }
+                    outsides_.push_back(p);
+                } else {
+                    coplanars_.push_back(p);
+                }
+            }
+            facets_.coplanar_ends_[f] = coplanars_.size();
+            facet_.outside_begin_ = outside_begin_;
+            facet_.outside_end_ = outsides_.size();
+            if (furthest != outside_begin_) {
+                std::swap(outsides_[outside_begin_], outsides_[furthest]);
+            }
+            rank(std::move(distance_), f);
         }
     }
 
-    using facet_unordered_set = std::unordered_set< size_type >;
+    bool
+    check_local_convexity(const_facet const & facet_,
+                          size_type const f) const
+    {
+        assert(facets_[f].normal_.data() == facet_.normal_.data());
+        for (size_type const n : facet_.neighbours_) {
+            const_facet const neighbour_ = facets_[n];
+            if (cos_of_dihedral_angle(facet_, neighbour_) < one) { // avoid roundoff error
+                for (size_type v = 0; v < dimension_; ++v) {
+                    if (neighbour_.neighbours_[v] == f) { // vertex v of neigbour_ facet is opposite to facet_
+                        value_type const distance_ = facet_.distance(coordinates(neighbour_.vertices_.indices()[v]));
+                        if (eps < distance_) {
+                            return false; // facet is not locally convex at ridge, common for facet_ and neighbour_ facets
+                        } else {
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
 
-    facet_unordered_set visited_;
-    facet_unordered_set visible_;
+    bool
+    check_local_convexity(facet_array const & _facets) const
+    {
+        return std::all_of(std::cbegin(_facets), std::cend(_facets), [&] (size_type const f) { return check_local_convexity(facets_[f], f); });
+    }
 
     bool
-    process_visibles(facet_array & _newfacets,
-                     size_type const f,
-                     point_iterator const _apex) // traverse the graph of visible facets
+    check_strict_convexity(facet_array const & _newfacets) const
+    { // vertices of neighbouring facets lie below each new facet by more then eps, otherwise the ridge is flat: a former vertex lies on the hull within eps, but it is not dropped
+        for (size_type const f : _newfacets) {
+            const_facet const facet_ = facets_[f];
+            for (size_type const n : facet_.neighbours_) {
+                const_facet const neighbour_ = facets_[n];
+                for (size_type v = 0; v < dimension_; ++v) {
+                    if (neighbour_.neighbours_[v] == f) { // vertex v of neigbour_ facet is opposite to facet_
+                        if (!(facet_.distance(coordinates(neighbour_.vertices_.indices()[v])) < -eps)) {
+                            return false;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    void
+    check_cone(facet_array const & _newfacets) // roundoff error can make the horizon not closed or the cone of new facets not locally convex, an apex extending a facet of the former hull makes a flat ridge
     {
-        assert(!(visited_.size() < visible_.size()));
-        if (!visited_.insert(f).second) {
-            return (visible_.count(f) != 0);
+        if (inserting_ && ((pending_ridges_ != 0) || !check_strict_convexity(_newfacets))) {
+            misoriented_ = true;
+            pending_ridges_ = 0; // the table of ridges is cleared for the next apex
         }
-        facet & facet_ = facets_[f];
-        if (!(zero < facet_.distance(std::cbegin(*_apex)))) {
-            return false;
+        assert(pending_ridges_ == 0);
+        assert(misoriented_ || check_local_convexity(_newfacets));
+    }
+
+    point_indices polygon_points_ = point_indices(allocator_); // points, which are not inside of initial triangle, in lexicographical order
+    point_indices polygon_ = point_indices(allocator_); // vertices of counterclockwise polygon: lower hull from the leftmost point to the rightmost one, then upper hull
+
+    // Andrew, A. M., 1979. "Another efficient algorithm for convex hulls in two dimensions", Information Processing Letters.
+    bool
+    create_convex_polygon()
+    { // vertices, outside and coplanar points of the edges of initial triangle are sorted, the polygon is built upon them by means of monotone chains
+        assert(dimension_ == 2);
+        assert(facets_.size() == 3);
+        polygon_points_.clear();
+        for (size_type f = 0; f < 3; ++f) {
+            facet const facet_ = facets_[f];
+            polygon_points_.insert(std::cend(polygon_points_), facet_.vertices_.indices(), facet_.vertices_.indices() + 2);
+            polygon_points_.insert(std::cend(polygon_points_), std::next(std::cbegin(outsides_), std::ptrdiff_t(facet_.outside_begin_)), std::next(std::cbegin(outsides_), std::ptrdiff_t(facet_.outside_end_)));
+            polygon_points_.insert(std::cend(polygon_points_), facet_.coplanar_.indices(), facet_.coplanar_.indices() + facet_.coplanar_.size());
         }
-        visible_.insert(f);
-        outside_.splice(std::cend(outside_), std::move(facet_.outside_));
-        facet_.coplanar_.clear();
-        for (size_type v = 0; v < dimension_; ++v) {
-            size_type const neighbour = facet_.neighbours_[v];
-            if (!process_visibles(_newfacets, neighbour, _apex)) { // recursive function
-                auto const newfacet = add_facet(facet_.vertices_, v, _apex, neighbour);
-                set_hyperplane_equation(newfacet.first);
-                _newfacets.push_back(newfacet.second);
-                replace_neighbour(neighbour, f, newfacet.second);
-                find_adjacent_facets(newfacet.first, newfacet.second, v);
+        bool ccw_; // orientation of the edges of initial triangle: inner point lies on the left of them
+        {
+            point_index const * const vertices_ = facets_.vertices(0);
+            crow const a = coordinates(vertices_[0]);
+            crow const b = coordinates(vertices_[1]);
+            ccw_ = (zero < (b[0] - a[0]) * (inner_point_[1] - a[1]) - (b[1] - a[1]) * (inner_point_[0] - a[0]));
+        }
+        std::sort(std::begin(polygon_points_), std::end(polygon_points_), [&] (point_index const l, point_index const r) -> bool
+        {
+            crow const a = coordinates(l);
+            crow const b = coordinates(r);
+            if (a[0] < b[0]) {
+                return true;
+            } else if (b[0] < a[0]) {
+                return false;
+            } else if (a[1] < b[1]) {
+                return true;
+            } else if (b[1] < a[1]) {
+                return false;
+            }
+            return (l < r); // vertices of the triangle are met several times
+        });
+        polygon_points_.erase(std::unique(std::begin(polygon_points_), std::end(polygon_points_)), std::end(polygon_points_));
+        auto const distance = [&] (point_index const s, point_index const r, point_index const x) -> value_type // signed distance from x to the line through s and r, positive on the right (outside of counterclockwise polygon)
+        {
+            crow const a = coordinates(s);
+            crow const b = coordinates(r);
+            crow const c = coordinates(x);
+            value_type const e[2] = {b[0] - a[0], b[1] - a[1]};
+            using std::sqrt;
+            return (e[1] * (c[0] - a[0]) - e[0] * (c[1] - a[1])) / sqrt(e[0] * e[0] + e[1] * e[1]);
+        };
+        polygon_.clear();
+        auto const push = [&] (point_index const r,
+                               size_type const _chain) // the first vertex of the chain
+        { // orientation tests are scalar: each one depends on the stack left by the previous one, so they cannot be batched like signed_distances()
+            while (_chain + 1 < polygon_.size()) {
+                size_type const size_ = polygon_.size();
+                if (eps < distance(polygon_[size_ - 2], r, polygon_[size_ - 1])) {
+                    break; // convex turn
+                }
+                polygon_.pop_back();
+            }
+            polygon_.push_back(r);
+        };
+        for (point_index const r : polygon_points_) { // lower hull
+            push(r, 0);
+        }
+        size_type const lower_ = polygon_.size(); // the last vertex of the lower hull is the rightmost point
+        for (auto r = std::next(std::crbegin(polygon_points_)); r != std::crend(polygon_points_); ++r) { // upper hull
+            push(*r, lower_ - 1);
+        }
+        polygon_.pop_back(); // the leftmost point again
+        size_type const size_ = polygon_.size();
+        if (!(2 < size_)) {
+            return false; // initial triangle is degenerate within eps: the facets are left intact
+        }
+        // e-th edge is from e-th vertex to the next one: [0; lower_ - 1) are edges of the lower hull, [lower_ - 1; size_) are edges of the upper hull
+        placements_.clear(); // (edge, point) for coplanar points
+        auto const place = [&] (size_type const e, point_index const r) -> bool
+        {
+            point_index const s = polygon_[e];
+            point_index const t = polygon_[(e + 1) % size_];
+            if ((r == s) || (r == t) || (distance(s, t, r) < -eps)) {
+                return false;
+            }
+            placements_.emplace_back(e, r);
+            return true;
+        };
+        auto const lower_begin_ = std::cbegin(polygon_);
+        auto const upper_begin_ = std::next(lower_begin_, std::ptrdiff_t(lower_ - 1));
+        for (point_index const r : polygon_points_) { // only edges, which cover x coordinate of the point, are tested
+            value_type const x = coordinates(r)[0];
+            size_type const i = size_type(std::partition_point(lower_begin_, upper_begin_, [&] (point_index const v) { return coordinates(v)[0] < x; }) - lower_begin_); // x coordinate does not decrease along the lower hull
+            if (((0 < i) && place(i - 1, r)) || ((i + 1 < lower_) && place(i, r))) {
+                continue;
+            }
+            size_type const j = size_type(std::partition_point(upper_begin_, std::cend(polygon_), [&] (point_index const v) { return x < coordinates(v)[0]; }) - lower_begin_); // x coordinate does not increase along the upper hull, the leftmost point closes it
+            if (!((lower_ - 1 < j) && place(j - 1, r)) && (j < size_)) {
+                place(j, r);
+            }
+        }
+        std::sort(std::begin(placements_), std::end(placements_));
+        ranking_.clear();
+        ranking_meta_.clear();
+        outsides_.clear();
+        dead_outsides_ = 0;
+        dead_coplanars_ = 0;
+        facets_.clear();
+        facets_.reserve(size_);
+        point_indices & coplanars_ = facets_.coplanars_;
+        auto placement_ = std::cbegin(placements_);
+        for (size_type e = 0; e < size_; ++e) {
+            facets_.emplace_back();
+            size_type const next_ = (e + 1) % size_;
+            size_type const prev_ = (e + size_ - 1) % size_;
+            point_index * const vertices_ = facets_.vertices(e);
+            size_type * const neighbours_ = facets_.neighbours(e);
+            if (ccw_) {
+                vertices_[0] = polygon_[e];
+                vertices_[1] = polygon_[next_];
+                neighbours_[0] = next_; // each neighbouring facet lies against corresponding vertex
+                neighbours_[1] = prev_;
+            } else {
+                vertices_[0] = polygon_[next_];
+                vertices_[1] = polygon_[e];
+                neighbours_[0] = prev_;
+                neighbours_[1] = next_;
+            }
+            facets_.coplanar_begins_[e] = coplanars_.size();
+            while ((placement_ != std::cend(placements_)) && (placement_->first == e)) {
+                coplanars_.push_back(placement_->second);
+                ++placement_;
+            }
+            facets_.coplanar_ends_[e] = coplanars_.size();
+            set_hyperplane_equation(facets_[e]);
+        }
+        QUICKHULL_STATISTICS_DO(statistics_.facets_added_ += facets_.size();)
+        QUICKHULL_STATISTICS_DO(statistics_.peak_facets_ = std::max(statistics_.peak_facets_, facets_.size());)
+        return true;
+    }
+
+    void
+    store_rows() // points, which are rows of the buffer of the caller, are stored as any other points
+    {
+        point_table & points_ = facets_.points_;
+        if (!points_.rows_) {
+            return;
+        }
+        assert(points_.iterators_.empty() && coordinates_.empty());
+        size_type const count_ = points_.rows_count_;
+        points_.iterators_.reserve(count_);
+        coordinates_.resize(count_ * dimension_);
+        for (size_type p = 0; p < count_; ++p) {
+            points_.iterators_.push_back(points_[p]);
+            std::copy_n(rows_ + p * rows_stride_, dimension_, coordinates_.data() + p * dimension_);
+        }
+        points_.rows_ = nullptr;
+        points_.rows_count_ = 0;
+        rows_ = coordinates_.data();
+        rows_stride_ = dimension_;
+    }
+
+    point_index
+    store_point(point_iterator const _point)
+    {
+        store_rows();
+        point_array & iterators_ = facets_.points_.iterators_;
+        assert(iterators_.size() < std::numeric_limits< point_index >::max());
+        point_index const p = point_index(iterators_.size());
+        iterators_.push_back(_point);
+        coordinates_.resize(coordinates_.size() + dimension_);
+        copy_point(_point, &coordinates_.back() + 1 - dimension_);
+        rows_ = coordinates_.data();
+        rows_stride_ = dimension_;
+        return p;
+    }
+
+    point_index
+    find_or_store_point(point_iterator const _point) // points of the buffer of the caller are not stored anew
+    {
+        if constexpr (point_table::rows_allowed) {
+            point_table const & points_ = facets_.points_;
+            if (points_.rows_) {
+                crow const x = &*std::cbegin(*_point);
+                crow const last_ = points_.rows_ + points_.rows_count_ * points_.stride_;
+                if (!std::less< crow >{}(x, points_.rows_) && std::less< crow >{}(x, last_)) {
+                    size_type const offset_ = size_type(x - points_.rows_);
+                    if ((offset_ % points_.stride_) == 0) {
+                        return point_index(offset_ / points_.stride_);
+                    }
+                }
+            }
+        }
+        return store_point(_point);
+    }
+
+    value_type
+    create_initial_simplex() // vertices are simplex_indices_
+    {
+        QUICKHULL_STATISTICS_DO(quick_hull_statistics::timer const timer_{statistics_.initial_simplex_time_};)
+        assert(simplex_indices_.size() == dimension_ + 1);
+        assert(facets_.empty());
+        crow const origin_ = coordinates(simplex_indices_.back());
+        copy_point(simplex_indices_.back(), inner_point_);
+        for (size_type r = 0; r < dimension_; ++r) { // affine space -> vector space
+            vrow const row_ = matrix_[r];
+            copy_point(simplex_indices_[r], row_);
+            for (size_type i = 0; i < dimension_; ++i) {
+                inner_point_[i] += row_[i];
             }
+            subtract(row_, origin_);
         }
-        unrank(f);
-        return true;
+        divide(inner_point_, value_type(dimension_ + 1));
+        value_type const volume_ = det(); // oriented hypervolume
+        bool const swap_ = (volume_ < zero);
+        facets_.reserve(dimension_ + 1);
+        for (size_type f = 0; f <= dimension_; ++f) {
+            facets_.emplace_back();
+            make_facet(f, simplex_indices_.data(), f, swap_);
+            set_hyperplane_equation(facets_.back());
+            newfacets_.push_back(f);
+        }
+        QUICKHULL_STATISTICS_DO(statistics_.facets_added_ += facets_.size();)
+        QUICKHULL_STATISTICS_DO(statistics_.peak_facets_ = std::max(statistics_.peak_facets_, facets_.size());)
+        partition(newfacets_);
+        newfacets_.clear();
+        assert(check());
+        return volume_;
     }
 
     void
-    compactify()
+    remove_facets() // points are retained
     {
-        size_type source = facets_.size();
-        assert(removed_facets_.size() < source);
-        assert(dimension_ < source - removed_facets_.size());
-        assert(ranking_.size() == ranking_meta_.size());
-        assert(!(source < ranking_.size()));
-        auto const rend = std::end(ranking_meta_);
-        std::sort(std::rbegin(removed_facets_), std::rend(removed_facets_));
-        for (size_type const destination : removed_facets_) {
-            assert(!(source < destination));
-            if (destination != --source) {
-                facet & facet_ = facets_[destination];
-                facet_ = std::move(facets_.back());
-                for (size_type const n : facet_.neighbours_) {
-                    replace_neighbour(n, source, destination);
-                }
-                auto const r = ranking_meta_.find(source);
-                if (r != rend) {
-                    r->second->second = destination;
-                    ranking_meta_.emplace(destination, std::move(r->second));
-                    ranking_meta_.erase(r);
-                }
-            }
-            facets_.pop_back();
-        }
+        facets_.clear();
+        outside_.clear();
+        outsides_.clear();
+        dead_outsides_ = 0;
+        dead_coplanars_ = 0;
         removed_facets_.clear();
+        ranking_.clear();
+        ranking_meta_.clear();
+        newfacets_.clear();
+        horizon_.visibles_.clear();
+        horizon_.ridges_.clear();
+        pending_ridges_ = 0;
+        inserting_ = false;
+        misoriented_ = false;
     }
 
-    bool
-    check_local_convexity(facet const & facet_,
-                          size_type const f) const
+    void
+    rebuild() // convex hull of all the points added since reset() is created from scratch
     {
-        assert(&facets_[f] == &facet_);
-        for (size_type const n : facet_.neighbours_) {
-            facet const & neighbour_ = facets_[n];
-            if (cos_of_dihedral_angle(facet_, neighbour_) < one) { // avoid roundoff error
-                for (size_type v = 0; v < dimension_; ++v) {
-                    if (neighbour_.neighbours_[v] == f) { // vertex v of neigbour_ facet is opposite to facet_
-                        value_type const distance_ = facet_.distance(std::cbegin(*neighbour_.vertices_[v]));
-                        if (eps < distance_) {
-                            return false; // facet is not locally convex at ridge, common for facet_ and neighbour_ facets
-                        } else {
-                            break;
-                        }
-                    }
-                }
+        QUICKHULL_STATISTICS_DO(++statistics_.rebuilds_;)
+        remove_facets();
+        size_type const count_ = facets_.points_.size();
+        for (size_type p = 0; p < count_; ++p) {
+            outside_.push_back(point_index(p));
+        }
+        auto const less_ = [&] (point_index const l, point_index const r) -> bool
+        {
+            crow const x = coordinates(l);
+            crow const y = coordinates(r);
+            if (std::lexicographical_compare(x, x + dimension_, y, y + dimension_)) {
+                return true;
             }
+            return !std::lexicographical_compare(y, y + dimension_, x, x + dimension_) && (l < r);
+        };
+        auto const equal_ = [&] (point_index const l, point_index const r) -> bool
+        {
+            crow const x = coordinates(l);
+            return std::equal(x, x + dimension_, coordinates(r));
+        };
+        std::sort(std::begin(outside_), std::end(outside_), less_);
+        outside_.erase(std::unique(std::begin(outside_), std::end(outside_), equal_), std::end(outside_)); // vertices of initial simplex are stored twice, if they are not rows of the buffer of the caller
+        std::sort(std::begin(outside_), std::end(outside_)); // the first of coincident points is retained, the order of addition is restored
+        find_affine_basis(simplex_indices_);
+        if (simplex_indices_.size() != dimension_ + 1) {
+            outside_.clear();
+            return; // superset of points of full-dimensional hull can be degenerate only within eps
         }
-        return true;
+        create_initial_simplex();
+        create_convex_hull();
     }
 
 public :
 
+    void
+    add_point(point_iterator const _point)
+    {
+        outside_.push_back(store_point(_point));
+    }
+
     template< typename iterator >
     value_type
     hypervolume(iterator first,
@@ -777,7 +2691,7 @@ public :
                point_iterator const end) // [beg; end)
     {
         while (beg != end) {
-            outside_.push_back(beg);
+            add_point(beg);
             ++beg;
         }
     }
@@ -790,25 +2704,166 @@ public :
         using iterator_traits = std::iterator_traits< iterator >;
         static_assert(std::is_base_of< std::input_iterator_tag, typename iterator_traits::iterator_category >::value);
         static_assert(std::is_constructible< point_iterator, typename iterator_traits::value_type >::value);
-        std::copy(beg, end, std::back_inserter(outside_));
+        for (auto it = beg; it != end; ++it) {
+            add_point(*it);
+        }
+    }
+
+    template< typename type = value_type, typename = std::enable_if_t< std::is_constructible< point_iterator, type const *, size_type, size_type >::value > >
+    void
+    add_points(type const * const _coordinates,
+               size_type const _count,
+               size_type const _stride) // _count rows of contiguous row-major matrix with _stride, e.g. point_iterator is row_iterator< value_type >
+    { // if no points are added before, then the rows are referenced in place by their indices (the buffer must outlive the use of the points), else coordinates are copied row by row
+        assert(!(_stride < dimension_));
+        point_table & points_ = facets_.points_;
+        assert(points_.size() + _count < std::numeric_limits< point_index >::max());
+        outside_.reserve(outside_.size() + _count);
+        if constexpr (std::is_same< type, value_type >::value) {
+            bool const first_ = (points_.size() == 0);
+            if (first_ || (points_.rows_ && (points_.stride_ == _stride) && (_coordinates == points_.rows_ + points_.rows_count_ * _stride))) { // the first or adjacent rows
+                if (first_) {
+                    points_.rows_ = _coordinates;
+                    points_.width_ = dimension_;
+                    points_.stride_ = _stride;
+                    rows_ = _coordinates;
+                    rows_stride_ = _stride;
+                }
+                for (size_type i = 0; i < _count; ++i) {
+                    outside_.push_back(point_index(points_.rows_count_++));
+                }
+                return;
+            }
+        }
+        store_rows();
+        point_array & iterators_ = points_.iterators_;
+        iterators_.reserve(iterators_.size() + _count);
+        size_type const size_ = coordinates_.size();
+        coordinates_.resize(size_ + _count * dimension_);
+        vrow to_ = coordinates_.data() + size_;
+        for (size_type i = 0; i < _count; ++i) {
+            crow const row_ = _coordinates + i * _stride;
+            outside_.push_back(point_index(iterators_.size()));
+            iterators_.emplace_back(row_, dimension_, _stride);
+            std::copy_n(row_, dimension_, to_);
+            to_ += dimension_;
+        }
+        rows_ = coordinates_.data();
+        rows_stride_ = dimension_;
+    }
+
+    // Akl, S. G., and G. T. Toussaint, 1978. "A fast convex hull algorithm", Information Processing Letters.
+    size_type
+    add_points_filtered(point_iterator const beg,
+                        point_iterator const end, // [beg; end)
+                        size_type const _directions = 0) // count of directions: at least 2 * d (along the axes), at most 2 * d^2 (pairwise diagonals as well)
+    { // points strictly inside of the convex hull of the points extreme along the directions are not added, returns count of culled points
+        size_type const count_ = std::min(std::max(_directions, 2 * dimension_), 2 * dimension_ * dimension_);
+        vector directions_(count_ * dimension_, zero, allocator_);
+        {
+            vrow direction_ = directions_.data();
+            for (size_type i = 0; i < dimension_; ++i) {
+                direction_[i] = one;
+                direction_ += dimension_;
+                direction_[i] = -one;
+                direction_ += dimension_;
+            }
+            for (size_type i = 0; i < dimension_; ++i) {
+                for (size_type j = i + 1; j < dimension_; ++j) {
+                    for (value_type const & sign_ : {one, -one}) {
+                        for (value_type const & orientation_ : {one, -one}) {
+                            if (direction_ == directions_.data() + directions_.size()) {
+                                break;
+                            }
+                            direction_[i] = sign_;
+                            direction_[j] = sign_ * orientation_;
+                            direction_ += dimension_;
+                        }
+                    }
+                }
+            }
+        }
+        if (beg == end) {
+            return 0;
+        }
+        vector point_(dimension_, allocator_);
+        vector extents_(count_, allocator_);
+        array< std::pair< size_type, point_iterator > > extremes_(count_, {0, beg}, allocator_); // ordinal numbers of extreme points and the points
+        {
+            copy_point(beg, point_.data());
+            for (size_type k = 0; k < count_; ++k) {
+                crow const direction_ = directions_.data() + k * dimension_;
+                extents_[k] = std::inner_product(direction_, direction_ + dimension_, point_.data(), zero);
+            }
+        }
+        size_type ordinal = 0;
+        for (point_iterator it = std::next(beg); it != end; ++it) { // extreme points
+            ++ordinal;
+            copy_point(it, point_.data());
+            for (size_type k = 0; k < count_; ++k) {
+                crow const direction_ = directions_.data() + k * dimension_;
+                value_type const extent_ = std::inner_product(direction_, direction_ + dimension_, point_.data(), zero);
+                if (extents_[k] < extent_) {
+                    extents_[k] = extent_;
+                    extremes_[k] = {ordinal, it};
+                }
+            }
+        }
+        std::sort(std::begin(extremes_), std::end(extremes_), [] (auto const & _lhs, auto const & _rhs) { return (_lhs.first < _rhs.first); });
+        extremes_.erase(std::unique(std::begin(extremes_), std::end(extremes_), [] (auto const & _lhs, auto const & _rhs) { return (_lhs.first == _rhs.first); }), std::end(extremes_));
+        array< size_type > ordinals_(allocator_);
+        point_array vertices_(allocator_);
+        for (auto const & extreme_ : extremes_) {
+            ordinals_.push_back(extreme_.first);
+            vertices_.push_back(extreme_.second);
+        }
+        quick_hull hull_(dimension_, eps, allocator_);
+        hull_.add_points(std::cbegin(vertices_), std::cend(vertices_));
+        point_list const basis_ = hull_.get_affine_basis();
+        if (basis_.size() != dimension_ + 1) {
+            add_points(beg, end); // extreme points are affinely dependent
+            return 0;
+        }
+        hull_.create_initial_simplex(std::cbegin(basis_), std::prev(std::cend(basis_)));
+        hull_.create_convex_hull();
+        size_type const planes_count_ = hull_.facets_.size();
+        vector planes_(allocator_); // packed equations of hyperplanes: normal and D
+        planes_.reserve(planes_count_ * (dimension_ + 1));
+        for (const_facet const facet_ : hull_.facets_) {
+            planes_.insert(std::cend(planes_), std::cbegin(facet_.normal_), std::cend(facet_.normal_));
+            planes_.push_back(facet_.D);
+        }
+        size_type culled_ = 0;
+        ordinal = 0;
+        for (point_iterator it = beg; it != end; ++it, ++ordinal) { // single streaming pass
+            copy_point(it, point_.data());
+            crow plane_ = planes_.data();
+            size_type p = 0;
+            for (; p < planes_count_; ++p) {
+                if (!(std::inner_product(plane_, plane_ + dimension_, point_.data(), plane_[dimension_]) < -eps)) {
+                    break; // not strictly inside
+                }
+                plane_ += (dimension_ + 1);
+            }
+            if ((p == planes_count_) && !std::binary_search(std::cbegin(ordinals_), std::cend(ordinals_), ordinal)) { // roundoff error can move vertices inside
+                ++culled_;
+            } else {
+                add_point(it);
+            }
+        }
+        return culled_;
     }
 
     point_list
     get_affine_basis()
     {
-        assert(facets_.empty());
-        point_list basis_;
-        basis_.splice(std::cend(basis_), outside_, std::begin(outside_));
-        if (!steal_best(basis_)) {
-            return basis_; // can't find affinely independent second point
-        }
-        outside_.splice(std::cbegin(outside_), basis_, std::begin(basis_)); // reject first point to rejudge it
-        for (size_type i = 0; i < dimension_; ++i) {
-            if (!steal_best(basis_)) {
-                return basis_; // can't find (i + 2) affinely independent points
-            }
+        point_indices basis_(allocator_);
+        find_affine_basis(basis_);
+        point_list affine_basis_(allocator_);
+        for (point_index const p : basis_) {
+            affine_basis_.push_back(facets_.points_[p]);
         }
-        return basis_;
+        return affine_basis_;
     }
 
     template< typename iterator >
@@ -820,64 +2875,128 @@ public :
         static_assert(std::is_base_of< std::forward_iterator_tag, typename iterator_traits::iterator_category >::value);
         static_assert(std::is_constructible< point_iterator, typename iterator_traits::value_type >::value);
         assert(static_cast< size_type >(std::distance(first, last)) == dimension_);
-        assert(facets_.empty());
-        {
-            copy_point(*last, inner_point_);
-            auto it = first;
-            while (it != last) {
-                auto x = std::cbegin(**it);
-                for (size_type i = 0; i < dimension_; ++i) {
-                    inner_point_[i] += *x;
-                    ++x;
-                }
-                ++it;
-            }
-            divide(inner_point_, value_type(dimension_ + 1));
-        }
-        value_type const volume_ = hypervolume(first, last);
-        bool const swap_ = (volume_ < zero);
-        for (size_type f = 0; f <= dimension_; ++f) {
-            facets_.emplace_back();
-            facet & facet_ = facets_.back();
-            make_facet(facet_, first, f, swap_);
-            set_hyperplane_equation(facet_);
-            rank(partition(facet_), f);
+        simplex_indices_.clear();
+        for (auto it = first; it != last; ++it) {
+            simplex_indices_.push_back(find_or_store_point(*it)); // vertices are not necessarily added before
         }
-        outside_.clear();
-        assert(check());
-        return volume_;
+        simplex_indices_.push_back(find_or_store_point(*last));
+        return create_initial_simplex();
     }
 
     // Barber, C. B., D.P. Dobkin, and H.T. Huhdanpaa, 1995. "The Quickhull Algorithm for Convex Hulls", ACM Transactions on Mathematical Software.
     void
     create_convex_hull()
     {
+        QUICKHULL_STATISTICS_DO(quick_hull_statistics::timer const timer_{statistics_.convex_hull_time_};)
         assert(facets_.size() == dimension_ + 1);
         assert(removed_facets_.empty());
-        facet_array newfacets_;
-        while (!ranking_.empty()) {
-            size_type const f = get_best_facet();
-            point_list & o_ = facets_[f].outside_;
-            assert(!o_.empty());
-            point_iterator const apex = std::move(o_.front());
-            o_.pop_front();
-            if (!process_visibles(newfacets_, f, apex)) {
-                assert(false);
-            }
-            visited_.clear();
-            visible_.clear();
-            assert(unique_ridges_.empty());
-            for (size_type const n : newfacets_) {
-                facet & facet_ = facets_[n];
-                assert(check_local_convexity(facet_, n));
-                rank(partition(facet_), n);
-            }
-            newfacets_.clear();
-            outside_.clear();
-            //assert((compactify(), check()));
+        if ((dimension_ == 2) && monotone_chain_ && create_convex_polygon()) {
+            return;
         }
-        assert(ranking_meta_.empty());
-        compactify();
+        process_ranking();
+    }
+
+    template< typename iterator >
+    void
+    insert_points(iterator const beg,
+                  iterator const end) // [beg; end): the convex hull created before is updated in place
+    {
+        assert(dimension_ < facets_.size());
+        assert(ranking_.empty());
+        assert(outside_.empty());
+        {
+            QUICKHULL_STATISTICS_DO(quick_hull_statistics::timer const timer_{statistics_.convex_hull_time_};)
+            add_points(beg, end);
+            {
+                QUICKHULL_STATISTICS_DO(quick_hull_statistics::timer const partition_timer_{statistics_.partition_time_};)
+                locate_outside();
+            }
+            inserting_ = true;
+            misoriented_ = false;
+            process_ranking();
+            inserting_ = false;
+        }
+        if (misoriented_) {
+            rebuild(); // roundoff error made the hull locally nonconvex: all the points (vertices and points inside included) are processed anew
+        }
+    }
+
+    void
+    remove_inner_points() // only vertices of the hull are retained (renumbered in order of addition), coplanar sets are cleared: memory of the points is proportional to the count of vertices
+    {
+        assert(dimension_ < facets_.size());
+        assert(ranking_.empty());
+        assert(outside_.empty());
+        store_rows();
+        point_table & points_ = facets_.points_;
+        point_array & iterators_ = points_.iterators_;
+        size_type const count_ = iterators_.size();
+        point_index const removed = std::numeric_limits< point_index >::max();
+        point_indices renumbering_(count_, removed, allocator_);
+        for (point_index const p : facets_.vertices_) {
+            renumbering_[p] = 0;
+        }
+        point_index size_ = 0;
+        for (size_type p = 0; p < count_; ++p) {
+            if (renumbering_[p] != removed) {
+                renumbering_[p] = size_;
+                if (size_ != p) {
+                    iterators_[size_] = iterators_[p];
+                    std::copy_n(coordinates_.data() + p * dimension_, dimension_, coordinates_.data() + size_ * dimension_);
+                }
+                ++size_;
+            }
+        }
+        iterators_.erase(std::next(std::begin(iterators_), std::ptrdiff_t(size_)), std::end(iterators_));
+        coordinates_.resize(size_ * dimension_);
+        rows_ = coordinates_.data();
+        for (point_index & p : facets_.vertices_) {
+            p = renumbering_[p];
+        }
+        std::fill(std::begin(facets_.coplanar_begins_), std::end(facets_.coplanar_begins_), 0);
+        std::fill(std::begin(facets_.coplanar_ends_), std::end(facets_.coplanar_ends_), 0);
+        facets_.coplanars_.clear();
+        dead_coplanars_ = 0;
+        simplex_indices_.clear();
+    }
+
+    template< typename type = value_type, typename = std::enable_if_t< std::is_constructible< point_iterator, type const *, size_type, size_type >::value > >
+    void
+    refer_points(type const * const _coordinates,
+                 size_type const _stride) // stored points are the rows of the buffer of the caller from now on (the rows are copies of the points in order of their indices), their own copies are released
+    {
+        assert(!(_stride < dimension_));
+        point_table & points_ = facets_.points_;
+        size_type const count_ = points_.size();
+        points_.iterators_.clear();
+        coordinates_.clear();
+        points_.rows_ = _coordinates;
+        points_.width_ = dimension_;
+        points_.stride_ = _stride;
+        points_.rows_count_ = count_;
+        rows_ = _coordinates;
+        rows_stride_ = _stride;
+    }
+
+    void
+    reset() // remove all the points and facets, but retain allocated memory for the next use
+    {
+        facets_.points_.clear();
+        coordinates_.clear();
+        rows_ = nullptr;
+        remove_facets();
+    }
+
+    void
+    reset(size_type const _dimension,
+          value_type const & _eps) // the same as construction of new instance (with the same allocator), but memory is retained
+    {
+        quick_hull_dimension< static_dimension >::set_dimension(_dimension);
+        facets_.set_dimension(_dimension);
+        eps = _eps;
+        layout();
+        ridges_.clear(); // size of keys depends on dimension_
+        reset();
     }
 
     // Kurt Mehlhorn, Stefan Näher, Thomas Schilz, Stefan Schirra, Michael Seel, Raimund Seidel, and Christian Uhrig.
@@ -887,28 +3006,27 @@ public :
     {
         assert(dimension_ < facets_.size());
         size_type facets_count_ = 0;
-        for (facet const & facet_ : facets_) { // check local convexity of all the facets
+        for (const_facet const facet_ : facets_) { // check local convexity of all the facets
             if (!check_local_convexity(facet_, facets_count_)) {
                 return false;
             }
             ++facets_count_;
         }
-        facet const & first_ = facets_.front();
+        const_facet const first_ = facets_.front();
         {
             value_type const distance_ = first_.distance(inner_point_);
             if (!(distance_ < zero)) {
                 return false; // inner point is not on negative side of the first facet, therefore structure is not convex
             }
         }
-        vector memory_(dimension_ * (4 + dimension_), zero);
+        vector memory_(dimension_ * (4 + dimension_), zero, allocator_);
         vrow centroid_ = memory_.data();
         vrow const ray_ = centroid_;
         centroid_ += dimension_;
-        for (point_iterator const & v : first_.vertices_) {
-            auto x = std::cbegin(*v);
+        for (size_type v = 0; v < dimension_; ++v) {
+            crow const x = coordinates(first_.vertices_.indices()[v]);
             for (size_type i = 0; i < dimension_; ++i) {
-                ray_[i] += *x;
-                ++x;
+                ray_[i] += x[i];
             }
         }
         divide(ray_, value_type(dimension_));
@@ -919,7 +3037,8 @@ public :
                 return false;
             }
         }
-        matrix g_{dimension_}; // storage (d * (d + 1)) for Gaussian elimination with partial pivoting
+        matrix g_ = make_array< vrow >(); // storage (d * (d + 1)) for Gaussian elimination with partial pivoting
+        allocate(g_);
         for (vrow & row_ : g_) {
             row_ = centroid_;
             centroid_ += (dimension_ + 1);
@@ -929,7 +3048,7 @@ public :
         assert(centroid_ + dimension_ == &memory_.back() + 1);
         for (size_type f = 1; f < facets_count_; ++f) {
             using std::abs;
-            facet const & facet_ = facets_[f];
+            const_facet const facet_ = facets_[f];
             value_type const numerator_ = facet_.distance(inner_point_);
             if (!(numerator_ < zero)) {
                 return false; // inner point is not on negative side of all the facets, i.e. structure is not convex
@@ -941,10 +3060,9 @@ public :
             std::copy_n(ray_, dimension_, intersection_point_);
             scale_and_shift(intersection_point_, inner_point_, -(numerator_ / denominator_));
             for (size_type v = 0; v < dimension_; ++v) {
-                auto beg = std::cbegin(*facet_.vertices_[v]);
+                crow const x = coordinates(facet_.vertices_.indices()[v]);
                 for (size_type r = 0; r < dimension_; ++r) {
-                    g_[r][v] = *beg;
-                    ++beg;
+                    g_[r][v] = x[r];
                 }
             }
             for (size_type r = 0; r < dimension_; ++r) {
@@ -952,20 +3070,20 @@ public :
                 centroid_[r] = -std::accumulate(gr_, gr_ + dimension_, zero) / value_type(dimension_);
                 gr_[dimension_] = intersection_point_[r];
             }
+            value_type extent_ = zero;
             for (size_type r = 0; r < dimension_; ++r) {
                 vrow const gr_ = g_[r];
-                value_type & x_ = centroid_[r];
-                gshift(gr_, x_);
+                gshift(gr_, centroid_[r]);
                 //assert(!(eps * value_type(dimension_) < std::accumulate(gr_, gr_ + dimension_, zero))); // now center of the facet coincides with the origin, but no one vertex does
                 auto const bounding_box = std::minmax_element(gr_, gr_ + dimension_);
-                x_ = *bounding_box.second - *bounding_box.first;
-                if (!(eps * value_type(dimension_) < x_)) {
-                    x_ = one;
-                }
+                extent_ = std::max(extent_, *bounding_box.second - *bounding_box.first);
             }
-            for (size_type r = 0; r < dimension_; ++r) {
+            if (!(eps * value_type(dimension_) < extent_)) {
+                extent_ = one;
+            }
+            for (size_type r = 0; r < dimension_; ++r) { // the facet is moved along its normal: the shifted vertices are linearly independent, but the shift along a bounding box may lie in the facet (e.g. any edge of positive slope in 2D)
                 vrow const gr_ = g_[r];
-                gshift(gr_, centroid_[r]);
+                gshift(gr_, extent_ * facet_.normal_[r]);
             }
             for (size_type i = 0; i < dimension_; ++i) { // Gaussian elimination
                 vrow & gi_ = g_[i];
@@ -1023,3 +3141,327 @@ public :
     }
 
 };
+
+// divide and conquer: hulls of K spatial slabs of the input are built concurrently, then the convex hull of the union of their vertices is built
+// the result has no facets, if the input does not contain (dimension + 1) affinely independent points
+template< typename point_iterator,
+          typename value_type >
+quick_hull< point_iterator, value_type >
+parallel_convex_hull(point_iterator const beg,
+                     point_iterator const end, // [beg; end)
+                     std::size_t const _dimension,
+                     value_type const & _eps,
+                     std::size_t const _threads = std::thread::hardware_concurrency())
+{
+    using size_type = std::size_t;
+    using quick_hull_type = quick_hull< point_iterator, value_type >;
+    using point_array = typename quick_hull_type::point_array;
+    constexpr size_type slab_size = 4096; // minimal count of points per slab
+    thread_pool thread_pool_(_threads);
+    point_array points_;
+    for (point_iterator it = beg; it != end; ++it) {
+        points_.push_back(it);
+    }
+    size_type const size_ = points_.size();
+    size_type const slabs = std::max(std::min(size_ / slab_size, thread_pool_.size()), size_type(1));
+    std::vector< point_array > vertices_(slabs);
+    if (slabs == 1) {
+        vertices_.front() = std::move(points_);
+    } else {
+        std::vector< size_type > bounds_(slabs + 1);
+        for (size_type s = 0; s <= slabs; ++s) {
+            bounds_[s] = (size_ * s) / slabs;
+        }
+        auto const less_ = [] (point_iterator const & _lhs, point_iterator const & _rhs) -> bool
+        {
+            return (*std::cbegin(*_lhs) < *std::cbegin(*_rhs));
+        };
+        auto const pbeg = std::begin(points_);
+        for (size_type s = 1; s < slabs; ++s) { // slabs along the first axis
+            std::nth_element(std::next(pbeg, std::ptrdiff_t(bounds_[s - 1])), std::next(pbeg, std::ptrdiff_t(bounds_[s])), std::end(points_), less_);
+        }
+        thread_pool_.parallel_for(slabs, [&] (size_type const s, size_type)
+        {
+            auto const sbeg = std::next(std::cbegin(points_), std::ptrdiff_t(bounds_[s]));
+            auto const send = std::next(std::cbegin(points_), std::ptrdiff_t(bounds_[s + 1]));
+            point_array & slab_vertices_ = vertices_[s];
+            quick_hull_type slab_hull_(_dimension, _eps);
+            slab_hull_.add_points(sbeg, send);
+            auto const basis_ = slab_hull_.get_affine_basis();
+            if (basis_.size() != _dimension + 1) {
+                slab_vertices_.assign(sbeg, send); // degenerated slab: none of the points can be discarded
+                return;
+            }
+            slab_hull_.create_initial_simplex(std::cbegin(basis_), std::prev(std::cend(basis_)));
+            slab_hull_.create_convex_hull();
+            auto indices_ = slab_hull_.facets_.vertices_; // each vertex is referenced by single point index
+            std::sort(std::begin(indices_), std::end(indices_));
+            indices_.erase(std::unique(std::begin(indices_), std::end(indices_)), std::end(indices_));
+            for (auto const p : indices_) {
+                slab_vertices_.push_back(slab_hull_.facets_.points_[p]);
+            }
+        });
+    }
+    quick_hull_type quick_hull_(_dimension, _eps);
+    quick_hull_.thread_pool_ = &thread_pool_;
+    for (point_array const & slab_vertices_ : vertices_) {
+        quick_hull_.add_points(std::cbegin(slab_vertices_), std::cend(slab_vertices_));
+    }
+    auto const basis_ = quick_hull_.get_affine_basis();
+    if (basis_.size() == _dimension + 1) {
+        quick_hull_.create_initial_simplex(std::cbegin(basis_), std::prev(std::cend(basis_)));
+        quick_hull_.create_convex_hull();
+    }
+    quick_hull_.thread_pool_ = nullptr;
+    return quick_hull_;
+}
+
+// convex hulls of many small independent sets of points, computed concurrently
+// an instance retains per-worker state (and its memory) between calls
+template< typename value_type,
+          std::size_t static_dimension = 0 >
+struct quick_hull_batch
+{
+
+    using size_type = std::size_t;
+    using quick_hull_type = quick_hull< row_iterator< value_type >, value_type, static_dimension >;
+    using point_index = typename quick_hull_type::point_index;
+
+    size_type const dimension_;
+
+    // facets of convex hull of c-th set are [offsets_[c]; offsets_[c + 1]), the hull is empty, if the set is degenerated
+    std::vector< size_type > offsets_;
+    std::vector< point_index > vertices_; // dimension_ (oriented) vertices of each facet, indices are relative to the first point of the set
+
+    quick_hull_batch(size_type const _dimension,
+                     value_type const & _eps,
+                     thread_pool & _thread_pool)
+        : dimension_(_dimension)
+        , thread_pool_(_thread_pool)
+    {
+        workers_.reserve(thread_pool_.size());
+        for (size_type w = 0; w < thread_pool_.size(); ++w) {
+            workers_.emplace_back(dimension_, _eps);
+        }
+    }
+
+    void
+    operator () (value_type const * const _coordinates, // row-major, dimension_ values per point
+                 size_type const * const _offsets, // compressed sparse rows: c-th set consists of points [_offsets[c]; _offsets[c + 1])
+                 size_type const _count) // count of sets
+    {
+        if (sets_.size() < _count) {
+            sets_.resize(_count);
+        }
+        for (worker & worker_ : workers_) {
+            worker_.vertices_.clear();
+        }
+        thread_pool_.parallel_for(_count, [&] (size_type const c, size_type const w)
+        {
+            worker & worker_ = workers_[w];
+            set & set_ = sets_[c];
+            set_.worker_ = w;
+            set_.begin_ = worker_.vertices_.size();
+            value_type const * const first_ = _coordinates + _offsets[c] * dimension_;
+            size_type const size_ = _offsets[c + 1] - _offsets[c];
+            if (dimension_ < size_) {
+                quick_hull_type & hull_ = worker_.hull_;
+                hull_.reset();
+                hull_.add_points(first_, size_, dimension_);
+                auto const basis_ = hull_.get_affine_basis();
+                if (basis_.size() == dimension_ + 1) {
+                    hull_.create_initial_simplex(std::cbegin(basis_), std::prev(std::cend(basis_)));
+                    hull_.create_convex_hull();
+                    for (auto const & facet_ : hull_.facets_) {
+                        for (auto const & vertex_ : facet_.vertices_) {
+                            worker_.vertices_.push_back(point_index(size_type(vertex_.data() - first_) / dimension_));
+                        }
+                    }
+                }
+            }
+            set_.end_ = worker_.vertices_.size();
+        });
+        offsets_.resize(_count + 1);
+        offsets_.front() = 0;
+        for (size_type c = 0; c < _count; ++c) {
+            set const & set_ = sets_[c];
+            offsets_[c + 1] = offsets_[c] + (set_.end_ - set_.begin_) / dimension_;
+        }
+        vertices_.resize(offsets_.back() * dimension_);
+        thread_pool_.parallel_for(thread_pool_.size(), [&] (size_type const t, size_type)
+        { // gather in order of sets
+            size_type const cbeg = (_count * t) / thread_pool_.size();
+            size_type const cend = (_count * (t + 1)) / thread_pool_.size();
+            for (size_type c = cbeg; c < cend; ++c) {
+                set const & set_ = sets_[c];
+                auto const vertices = std::cbegin(workers_[set_.worker_].vertices_);
+                std::copy(std::next(vertices, std::ptrdiff_t(set_.begin_)), std::next(vertices, std::ptrdiff_t(set_.end_)), std::next(std::begin(vertices_), std::ptrdiff_t(offsets_[c] * dimension_)));
+            }
+        });
+    }
+
+#if defined(QUICKHULL_STATISTICS)
+    quick_hull_statistics
+    statistics() const // merged over the workers, wall times are summed up
+    {
+        quick_hull_statistics statistics_;
+        for (worker const & worker_ : workers_) {
+            statistics_ += worker_.hull_.statistics_;
+        }
+        return statistics_;
+    }
+#endif
+
+private :
+
+    struct worker
+    {
+
+        quick_hull_type hull_; // reused for all the sets processed by the worker
+        std::vector< point_index > vertices_;
+
+        worker(size_type const _dimension,
+               value_type const & _eps)
+            : hull_(_dimension, _eps)
+        { ; }
+
+    };
+
+    struct set
+    {
+
+        size_type worker_;
+        size_type begin_; // [begin_; end_) of vertices_ of the worker
+        size_type end_;
+
+    };
+
+    thread_pool & thread_pool_;
+    std::vector< worker > workers_;
+    std::vector< set > sets_;
+
+};
+
+template< typename value_type,
+          std::size_t static_dimension = 0 >
+struct quick_hull_stream // convex hull of the points, which are consumed chunk by chunk: only vertices of current hull and the chunk are kept in memory (all the points, while they lie in a proper affine subspace)
+{
+
+    using size_type = std::size_t;
+    using quick_hull_type = quick_hull< row_iterator< value_type >, value_type, static_dimension >;
+    using point_index = typename quick_hull_type::point_index;
+
+    size_type const dimension_;
+    size_type const chunk_size_; // count of points per chunk
+
+    std::vector< value_type > vertices_; // row-major coordinates of vertices of current hull (or of all the points, while they lie in a proper affine subspace)
+    quick_hull_type hull_; // hull of vertices_ (updated in place by each chunk), thread_pool_ and other options can be set
+
+    quick_hull_stream(size_type const _dimension,
+                      value_type const & _eps,
+                      size_type const _chunk_size = (size_type(1) << 20))
+        : dimension_(_dimension)
+        , chunk_size_(_chunk_size)
+        , hull_(_dimension, _eps)
+        , chunk_(_chunk_size * _dimension)
+    {
+        assert(0 < chunk_size_);
+    }
+
+    template< typename source, typename = std::enable_if_t< std::is_invocable_r< size_type, source &, value_type *, size_type >::value > >
+    size_type
+    add_points(source && _source) // _source(coordinates, count) writes up to count points (row-major) and returns count of points written, zero at the end of the stream
+    {
+        size_type size_ = 0;
+        for (;;) {
+            size_type const count_ = _source(chunk_.data(), chunk_size_);
+            assert(!(chunk_size_ < count_));
+            if (count_ == 0) {
+                break;
+            }
+            size_ += count_;
+            update(chunk_.data(), count_);
+        }
+        update(nullptr, 0); // points of the hull refer to vertices_ only
+        return size_;
+    }
+
+    size_type
+    add_points(std::istream & _in) // whitespace separated coordinates up to the end of the stream or to the first malformed value
+    {
+        return add_points([&] (value_type * const _coordinates, size_type const _count) -> size_type
+        {
+            for (size_type i = 0; i < _count; ++i) {
+                for (size_type j = 0; j < dimension_; ++j) {
+                    if (!(_in >> _coordinates[i * dimension_ + j])) {
+                        return i; // incomplete point is dropped
+                    }
+                }
+            }
+            return _count;
+        });
+    }
+
+    size_type
+    vertices_count() const
+    {
+        return vertices_.size() / dimension_;
+    }
+
+    bool
+    complete() const // points span the space, therefore hull_ is built
+    {
+        return complete_;
+    }
+
+private :
+
+    std::vector< value_type > chunk_;
+    std::vector< value_type > spare_vertices_;
+    bool complete_ = false;
+
+    void
+    update(value_type const * const _chunk,
+           size_type const _count) // replace vertices_ by vertices of convex hull of the points of vertices_ and of the chunk
+    {
+        if (complete_) { // the hull is updated in place by insert_points, it is not rebuilt for each chunk
+            if (_count != 0) {
+                using point_iterator = row_iterator< value_type >;
+                hull_.insert_points(point_iterator(_chunk, dimension_, dimension_), point_iterator(_chunk + _count * dimension_, dimension_, dimension_));
+                retain_vertices();
+            }
+            return;
+        }
+        hull_.reset();
+        vertices_.insert(std::cend(vertices_), _chunk, _chunk + _count * dimension_); // hull_ refers to rows of vertices_ in place
+        size_type const size_ = vertices_count();
+        if (!(dimension_ < size_)) {
+            return;
+        }
+        hull_.add_points(vertices_.data(), size_, dimension_);
+        auto const basis_ = hull_.get_affine_basis();
+        if (basis_.size() != dimension_ + 1) { // degenerated so far: all the points are retained and the hull is created from scratch for the next chunk
+            hull_.reset();
+            return;
+        }
+        hull_.create_initial_simplex(std::cbegin(basis_), std::prev(std::cend(basis_)));
+        hull_.create_convex_hull();
+        complete_ = true;
+        retain_vertices();
+    }
+
+    void
+    retain_vertices() // points inside of the hull are dropped, vertices_ are the rows of the rest, hull_ refers to them in place
+    {
+        hull_.remove_inner_points();
+        spare_vertices_.clear();
+        size_type const size_ = hull_.facets_.points_.size();
+        for (size_type p = 0; p < size_; ++p) {
+            value_type const * const row_ = hull_.facets_.points_[p].data(); // rows of previous vertices_ or of the chunk
+            spare_vertices_.insert(std::cend(spare_vertices_), row_, row_ + dimension_);
+        }
+        vertices_.swap(spare_vertices_);
+        hull_.refer_points(vertices_.data(), dimension_);
+    }
+
+};
@@ -0,0 +1,585 @@
+/* Generator of random sets of points (sphere, ball, cube, simplices, diamonds and so on)
+ *
+ * Copyright (c) 2014-2015, Anatoliy V. Tomilov
+ * Copyright (c) 2026, quickhull contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following condition is met:
+ * Redistributions of source code must retain the above copyright notice, this condition and the following disclaimer.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "point_file.hpp"
+#include "thread_pool.hpp"
+
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <valarray>
+#include <deque>
+#include <vector>
+#include <random>
+#include <limits>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cassert>
+
+template< typename G >
+struct randombox
+{
+
+    using size_type = std::size_t;
+
+    G const eps = std::numeric_limits< G >::epsilon();
+    G const zero = G(0);
+    G const one = G(1);
+
+    using seed_type = typename std::mt19937_64::result_type;
+    seed_type seed_;
+    std::mt19937_64 random_;
+
+    void
+    set_seed(seed_type const _seed)
+    {
+        seed_ = _seed;
+        random_.seed(seed_);
+    }
+
+    void
+    set_seed()
+    {
+#if 0
+        std::random_device rd_;
+        seed_ = rd_();
+#else
+        seed_ = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+#endif
+        random_.seed(seed_);
+    }
+
+    using point_type = std::valarray< G >;
+    using points_type = std::deque< point_type >;
+    using mask_array_type = std::valarray< bool >;
+
+    size_type const default_dimension = 3;
+    size_type dimension_ = default_dimension;
+    points_type source_points_;
+    points_type separate_points_;
+    points_type resulting_points_;
+    size_type count_ = 0;
+    G bounding_box_ = one;
+
+    std::normal_distribution< G > N_; // standard normal distribution
+    std::uniform_real_distribution< G > zero_to_one_; // uniform [0;1] ditribution
+
+    // sphere, ball and cube can be generated by blocks of points into contiguous buffer
+    // each block has its own random stream seeded by (seed, block number), so the result does not depend on count of threads
+    static constexpr size_type block_size = size_type(1) << 16; // points per block
+    thread_pool * thread_pool_ = nullptr; // blocks are generated and output concurrently, if set
+    std::vector< G > coordinates_; // row-major points generated by blocks, they follow resulting_points_ in output
+    size_type blocks_count_ = 0; // total count of blocks generated, next generated body get subsequent random streams
+
+    randombox()
+        : zero_to_one_(zero, std::nextafter(one, one + one)) // ? std::nextafter(zero, one)
+    { ; }
+
+    std::istream &
+    operator () (std::istream & _in)
+    {
+        if (!!_in) {
+            std::string line_;
+            if (!std::getline(_in, line_)) {
+                throw std::runtime_error("input: no 'dimensionality' value at first line");
+            }
+            std::istringstream iss_(line_);
+            if (!(iss_ >> dimension_)) {
+                throw std::runtime_error("input: bad 'dimensionality' value at first line");
+            }
+            if (!std::getline(_in, line_)) {
+                throw std::runtime_error("input: no 'count' value at second line");
+            }
+            iss_.clear();
+            iss_.str(line_);
+            size_type size_;
+            if (!(iss_ >> size_)) {
+                throw std::runtime_error("input: bad 'count' value at second line");
+            }
+            iss_.clear();
+            for (size_type i = 0; i < size_; ++i) {
+                if (!std::getline(_in, line_) || line_.empty()) {
+                    throw std::runtime_error("input: empty line or no 'count' lines with points coordinates");
+                }
+                if (line_.front() != '#') {
+                    iss_.str(line_);
+                    source_points_.emplace_back(dimension_);
+                    for (G & component_ : source_points_.back()) {
+                        if (!(iss_ >> component_)) {
+                            throw std::runtime_error("input: bad point format");
+                        }
+                    }
+                    iss_.clear();
+                }
+            }
+        }
+        return _in;
+    }
+
+    std::ostream &
+    operator () (std::ostream & _out) const
+    {
+        assert(0 < dimension_);
+        std::ios state_(nullptr);
+        state_.copyfmt(_out);
+        {
+            _out << dimension_ << '\n';
+            size_type const size_ = resulting_points_.size() + coordinates_.size() / dimension_;
+            //assert(0 < size_);
+            _out << size_ << '\n';
+            _out.precision(std::numeric_limits< G >::digits10);
+            for (point_type const & point_ : resulting_points_) {
+                assert(point_.size() == dimension_);
+                auto const last = std::prev(std::end(point_));
+                for (auto it = std::begin(point_); it != last; ++it) {
+                    _out << *it << ' ';
+                }
+                _out << *last << '\n';
+            }
+            write_blocks(_out);
+        }
+        _out.copyfmt(state_);
+        return _out;
+    }
+
+    template< typename value_type >
+    bool
+    write_binary(std::ostream & _out) const // see binary_header in point_file.hpp
+    {
+        size_type const blocks_size_ = coordinates_.size() / dimension_;
+        write_points_header< value_type >(_out, dimension_, resulting_points_.size() + blocks_size_);
+        std::vector< value_type > payload_;
+        payload_.reserve(std::max(resulting_points_.size(), std::min(blocks_size_, block_size)) * dimension_);
+        for (point_type const & point_ : resulting_points_) {
+            assert(point_.size() == dimension_);
+            for (G const & component_ : point_) {
+                payload_.push_back(value_type(component_));
+            }
+        }
+        _out.write(reinterpret_cast< char const * >(payload_.data()), std::streamsize(sizeof(value_type) * payload_.size()));
+        for (size_type i = 0; i < coordinates_.size(); i += block_size * dimension_) { // converted by blocks
+            size_type const size_ = std::min(coordinates_.size() - i, block_size * dimension_);
+            payload_.resize(size_);
+            std::copy_n(std::next(std::cbegin(coordinates_), std::ptrdiff_t(i)), size_, std::begin(payload_));
+            _out.write(reinterpret_cast< char const * >(payload_.data()), std::streamsize(sizeof(value_type) * size_));
+        }
+        return !!_out;
+    }
+
+    void
+    write_blocks(std::ostream & _out) const // formatting of blocks of coordinates_ is concurrent, output is in order
+    {
+        size_type const blocks_ = (coordinates_.size() / dimension_ + block_size - 1) / block_size;
+        size_type const round_size_ = (thread_pool_ ? 2 * thread_pool_->size() : 1); // count of blocks formatted at once
+        std::vector< std::string > texts_(round_size_);
+        auto const format_block = [&] (size_type const b, size_type const t)
+        {
+            std::string & text_ = texts_[t];
+            text_.clear();
+            size_type const first_ = b * block_size * dimension_;
+            size_type const last_ = std::min(coordinates_.size(), first_ + block_size * dimension_);
+            char number_[64];
+            for (size_type i = first_; i < last_; ++i) {
+                int length_;
+                if constexpr (std::is_same< G, long double >::value) {
+                    length_ = std::snprintf(number_, sizeof(number_), "%.*Lg", std::numeric_limits< G >::digits10, coordinates_[i]);
+                } else {
+                    length_ = std::snprintf(number_, sizeof(number_), "%.*g", std::numeric_limits< G >::digits10, double(coordinates_[i]));
+                }
+                text_.append(number_, size_type(length_));
+                text_.push_back((((i + 1) % dimension_) == 0) ? '\n' : ' ');
+            }
+        };
+        for (size_type b = 0; b < blocks_; b += round_size_) {
+            size_type const round_count_ = std::min(round_size_, blocks_ - b);
+            auto const format_round = [&] (size_type const t, size_type)
+            {
+                format_block(b + t, t);
+            };
+            if (thread_pool_) {
+                thread_pool_->parallel_for(round_count_, format_round);
+            } else {
+                format_round(0, 0);
+            }
+            for (size_type t = 0; t < round_count_; ++t) {
+                _out.write(texts_[t].data(), std::streamsize(texts_[t].size()));
+            }
+        }
+    }
+
+    void
+    set_dimension(size_type const _dimension)
+    {
+        if (0 < _dimension) {
+            if (dimension_ != _dimension) {
+                size_type const subdimension_ = std::min(dimension_, _dimension);
+                for (point_type & point_ : source_points_) {
+                    point_type storage_ = std::move(point_);
+                    point_.resize(_dimension, zero);
+                    std::copy_n(std::begin(storage_), subdimension_, std::begin(point_));
+                }
+                dimension_ = _dimension;
+            }
+        }
+    }
+
+    point_type
+    get_point(std::string const & _components)
+    {
+        point_type point_(zero, dimension_);
+        if (!_components.empty()) { // implicit point is origin
+            std::istringstream iss_(_components);
+            for (G & component_ : point_) {
+                if (!(iss_ >> component_)) {
+                    throw std::runtime_error("input: bad coordinate value");
+                }
+            }
+        }
+        return point_;
+    }
+
+    void
+    add_point(point_type && _point)
+    {
+        separate_points_.push_back(std::move(_point));
+    }
+
+    void
+    add_point(point_type const & _point)
+    {
+        separate_points_.push_back(_point);
+    }
+
+    void
+    add_point(std::string const & _components)
+    {
+        return add_point(get_point(_components));
+    }
+
+    void
+    set_count(size_type const _count)
+    {
+        if (_count == 0) {
+            count_ = dimension_ + 1;
+        } else {
+            count_ = _count;
+        }
+    }
+
+    void
+    set_bounding_box(G const & _bounding_box)
+    {
+        assert(eps < _bounding_box);
+        bounding_box_ = _bounding_box;
+    }
+
+    void
+    pick_unit_cube_point(point_type & _point)
+    {
+        for (G & component_ : _point) {
+            component_ = zero_to_one_(random_);
+        }
+    }
+
+    point_type
+    pick_unit_cube_point(size_type const _dimension)
+    {
+        point_type point_(_dimension);
+        pick_unit_cube_point(point_);
+        return point_;
+    }
+
+    template< typename generate_point >
+    void
+    add_blocks(generate_point && _generate_point) // _generate_point(random, normal, zero_to_one, point) fills dimension_ components of point
+    {
+        size_type const offset_ = coordinates_.size();
+        coordinates_.resize(offset_ + count_ * dimension_);
+        size_type const blocks_ = (count_ + block_size - 1) / block_size;
+        auto const generate_block = [&] (size_type const b, size_type)
+        {
+            std::uint64_t const block_ = blocks_count_ + b;
+            std::seed_seq seed_sequence_{std::uint32_t(seed_), std::uint32_t(std::uint64_t(seed_) >> 32),
+                                         std::uint32_t(block_), std::uint32_t(block_ >> 32)};
+            std::mt19937_64 block_random_(seed_sequence_);
+            std::normal_distribution< G > normal_;
+            std::uniform_real_distribution< G > block_zero_to_one_(zero, std::nextafter(one, one + one));
+            size_type const last_ = std::min(count_, (b + 1) * block_size);
+            G * point_ = coordinates_.data() + offset_ + b * block_size * dimension_;
+            for (size_type i = b * block_size; i < last_; ++i) {
+                _generate_point(block_random_, normal_, block_zero_to_one_, point_);
+                point_ += dimension_;
+            }
+        };
+        if (thread_pool_) {
+            thread_pool_->parallel_for(blocks_, generate_block);
+        } else {
+            for (size_type b = 0; b < blocks_; ++b) {
+                generate_block(b, 0);
+            }
+        }
+        blocks_count_ += blocks_;
+    }
+
+    template< typename random, typename normal >
+    void
+    pick_sphere_point(random & _random,
+                      normal & _normal,
+                      G * const _point) const
+    {
+        for (;;) {
+            G norm_ = zero;
+            for (size_type j = 0; j < dimension_; ++j) {
+                _point[j] = _normal(_random);
+                norm_ += _point[j] * _point[j];
+            }
+            using std::sqrt;
+            norm_ = sqrt(norm_);
+            if (!(norm_ < eps)) {
+                for (size_type j = 0; j < dimension_; ++j) {
+                    _point[j] /= norm_;
+                }
+                return;
+            }
+        }
+    }
+
+    void
+    add_sphere_blocks()
+    {
+        add_blocks([&] (auto & _random, auto & _normal, auto &, G * const _point)
+        {
+            pick_sphere_point(_random, _normal, _point);
+        });
+    }
+
+    void
+    add_ball_blocks()
+    {
+        G const power_ = (one / G(dimension_));
+        add_blocks([&] (auto & _random, auto & _normal, auto & _zero_to_one, G * const _point)
+        {
+            pick_sphere_point(_random, _normal, _point);
+            using std::pow;
+            G const radius_ = pow(_zero_to_one(_random), power_);
+            for (size_type j = 0; j < dimension_; ++j) {
+                _point[j] *= radius_;
+            }
+        });
+    }
+
+    void
+    add_unit_cube_blocks()
+    {
+        add_blocks([&] (auto & _random, auto &, auto & _zero_to_one, G * const _point)
+        {
+            for (size_type j = 0; j < dimension_; ++j) {
+                _point[j] = _zero_to_one(_random);
+            }
+        });
+    }
+
+    void
+    add_unit_cube()
+    {
+        for (size_type i = 0; i < count_; ++i) {
+            resulting_points_.push_back(pick_unit_cube_point(dimension_));
+        }
+    }
+
+    void
+    generate_parallelotope()
+    {
+        assert(!(dimension_ + 1 < source_points_.size()));
+        assert(1 < source_points_.size());
+        point_type const & vertex_ = separate_points_.front();
+        auto const vbeg = std::next(separate_points_.cbegin());
+        auto const vend = separate_points_.cend();
+        point_type point_(separate_points_.size() - 1);
+        for (size_type i = 0; i < count_; ++i) {
+            pick_unit_cube_point(point_);
+            resulting_points_.push_back(std::inner_product(vbeg, vend, std::begin(point_), vertex_));
+        }
+    }
+
+    void
+    add_diamond_surface()
+    {
+        add_unit_simplex();
+        std::uniform_int_distribution< size_type > flip_sign_(0, 1);
+        for (point_type & point_ : resulting_points_) {
+            for (G & component_ : point_) {
+                if (flip_sign_(random_) == 0) {
+                    component_ = -component_;
+                }
+            }
+        }
+    }
+
+    void
+    add_diamond_solid()
+    {
+        std::uniform_int_distribution< size_type > flip_sign_(0, 1);
+        point_type point_(dimension_ + 1);
+        for (size_type i = 0; i < count_; ++i) {
+            pick_uint_simplex_point(point_);
+            resulting_points_.emplace_back(dimension_);
+            point_type & destination_ = resulting_points_.back();
+            for (size_type j = 0; j < dimension_; ++j) {
+                if (flip_sign_(random_) == 0) {
+                    destination_[j] =  point_[j];
+                } else {
+                    destination_[j] = -point_[j];
+                }
+            }
+        }
+    }
+
+    void
+    pick_uint_simplex_point(point_type & _point)
+    {
+        pick_unit_cube_point(_point);
+        _point = -std::log(_point);
+        G norm_ = _point.sum();
+        if (norm_ == std::numeric_limits< G >::infinity()) { // if some of logarithms of generated values is -HUGE_VAL, then the correspoinding non-normalized value is one
+            mask_array_type const ones_ = (_point == std::numeric_limits< G >::infinity()); // store into std::valarray< bool > to prevent evaluations to being lazy
+            _point[ones_] = one;
+            _point[!ones_] = zero;
+            norm_ = _point.sum(); // number of close-to-zero generated values, can be zero (if there just an overflow)
+        }
+        if (eps < norm_) {
+            _point *= (one / std::move(norm_));
+        } else {
+            _point = zero; // if generated random point is too close to the origin, then assume, that origin is good choise
+        }
+    }
+
+    point_type
+    pick_uint_simplex_point(size_type const _dimension)
+    {
+        point_type point_(_dimension);
+        pick_uint_simplex_point(point_);
+        return point_;
+    }
+
+    void
+    add_unit_simplex()
+    {
+        for (size_type i = 0; i < count_; ++i) {
+            resulting_points_.push_back(pick_uint_simplex_point(dimension_));
+        }
+    }
+
+    void
+    generate_simplex()
+    {
+        assert(!(dimension_ + 1 < source_points_.size()));
+        assert(1 < source_points_.size());
+        auto const pbeg = separate_points_.cbegin();
+        auto const pend = separate_points_.cend();
+        point_type point_(separate_points_.size());
+        for (size_type i = 0; i < count_; ++i) {
+            pick_uint_simplex_point(point_);
+            resulting_points_.push_back(std::inner_product(pbeg, pend, std::begin(point_), point_type(zero, dimension_)));
+        }
+    }
+
+    void
+    add_sphere()
+    {
+        point_type source_(dimension_);
+        while (resulting_points_.size() < count_) {
+            for (size_type j = 0; j < dimension_; ++j) {
+                source_[j] = N_(random_);
+            }
+            resulting_points_.push_back(source_);
+            source_ *= source_;
+            using std::sqrt;
+            G norm_ = sqrt(source_.sum());
+            if (norm_ < eps) {
+                resulting_points_.pop_back();
+            } else {
+                resulting_points_.back() *= (one / std::move(norm_));
+            }
+        }
+    }
+
+    void
+    add_ball()
+    {
+        add_sphere();
+        G const power_ = (one / G(dimension_));
+        for (point_type & destination_ : resulting_points_) {
+            using std::pow;
+            destination_ *= pow(zero_to_one_(random_), power_);
+        }
+    }
+
+    void
+    project_to_cylinder()
+    {
+        assert(separate_points_.size() == 1);
+        point_type const & element_ = separate_points_.back();
+        for (size_type i = 0; i < count_; ++i) {
+            resulting_points_.push_back(source_points_[i] + element_ * zero_to_one_(random_));
+        }
+    }
+
+    void
+    project_to_cone()
+    {
+        assert(separate_points_.size() == 1);
+        point_type const & peak_ = separate_points_.back();
+        G const power_ = (one / G(dimension_));
+        for (size_type i = 0; i < count_; ++i) {
+            using std::pow;
+            G const p_ = pow(zero_to_one_(random_), power_);
+            resulting_points_.push_back(source_points_[i] * p_ + peak_ * (one - p_));
+        }
+    }
+
+};
+
+template< typename G >
+std::istream &
+operator >> (std::istream & _in, randombox< G > & _randombox)
+{
+    return _randombox(_in);
+}
+
+template< typename G >
+std::ostream &
+operator << (std::ostream & _out, randombox< G > const & _randombox)
+{
+    return _randombox(_out);
+}
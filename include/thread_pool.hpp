@@ -0,0 +1,152 @@
+/* Minimal thread pool for data parallel loops
+ *
+ * Copyright (c) 2026, quickhull contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following condition is met:
+ * Redistributions of source code must retain the above copyright notice, this condition and the following disclaimer.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <type_traits>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+
+#include <cstdint>
+#include <cassert>
+
+struct thread_pool // calling thread participates in the work as worker #0, parallel_for is not reentrant
+{
+
+    using size_type = std::size_t;
+
+    explicit
+    thread_pool(size_type const _concurrency = std::thread::hardware_concurrency())
+    {
+        size_type const workers_ = std::max< size_type >(_concurrency, 1);
+        threads_.reserve(workers_ - 1);
+        for (size_type w = 1; w < workers_; ++w) {
+            threads_.emplace_back(&thread_pool::work, this, w);
+        }
+    }
+
+    thread_pool(thread_pool const &) = delete;
+    thread_pool & operator = (thread_pool const &) = delete;
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard< std::mutex > lock_(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread & thread_ : threads_) {
+            thread_.join();
+        }
+    }
+
+    size_type
+    size() const // count of workers
+    {
+        return threads_.size() + 1;
+    }
+
+    template< typename function >
+    void
+    parallel_for(size_type const _count,
+                 function && _function) // calls _function(task, worker) for each task in [0; _count), returns when all the tasks are done
+    {
+        if ((_count < 2) || threads_.empty()) {
+            for (size_type t = 0; t < _count; ++t) {
+                _function(t, size_type(0));
+            }
+            return;
+        }
+        using callable = std::remove_reference_t< function >;
+        {
+            std::lock_guard< std::mutex > lock_(mutex_);
+            callable_ = const_cast< void * >(static_cast< void const * >(std::addressof(_function)));
+            invoke_ = [] (void * const _callable, size_type const _task, size_type const _worker)
+            {
+                (*static_cast< callable * >(_callable))(_task, _worker);
+            };
+            count_ = _count;
+            next_.store(0, std::memory_order_relaxed);
+            busy_ = threads_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+        run(0);
+        std::unique_lock< std::mutex > lock_(mutex_);
+        done_.wait(lock_, [&] { return (busy_ == 0); });
+    }
+
+private :
+
+    std::vector< std::thread > threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    void * callable_ = nullptr;
+    void (* invoke_)(void *, size_type, size_type) = nullptr;
+    size_type count_ = 0;
+    std::atomic< size_type > next_{0};
+    size_type busy_ = 0;
+    size_type generation_ = 0;
+    bool stop_ = false;
+
+    void
+    run(size_type const _worker)
+    {
+        for (;;) {
+            size_type const t = next_.fetch_add(1, std::memory_order_relaxed);
+            if (!(t < count_)) {
+                break;
+            }
+            invoke_(callable_, t, _worker);
+        }
+    }
+
+    void
+    work(size_type const _worker)
+    {
+        size_type generation = 0;
+        for (;;) {
+            {
+                std::unique_lock< std::mutex > lock_(mutex_);
+                wake_.wait(lock_, [&] { return (stop_ || (generation != generation_)); });
+                if (stop_) {
+                    return;
+                }
+                generation = generation_;
+            }
+            run(_worker);
+            {
+                std::lock_guard< std::mutex > lock_(mutex_);
+                if (--busy_ == 0) {
+                    done_.notify_one();
+                }
+            }
+        }
+    }
+
+};
@@ -0,0 +1,565 @@
+#include <quickhull.hpp>
+#include <randombox.hpp>
+#include <point_file.hpp>
+
+#include <filesystem>
+#include <iterator>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <ostream>
+#include <fstream>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+#include <cstdlib>
+#include <cmath>
+
+#ifndef QUICKHULL_SAMPLES_DIR
+#define QUICKHULL_SAMPLES_DIR "test/samples"
+#endif
+
+struct benchmark // times phases of quick_hull on generated bodies and on sample files, results are written in JSON
+{
+
+    using size_type = std::size_t;
+    using value_type = double;
+    using point_iterator = row_iterator< value_type >;
+    using quick_hull_type = quick_hull< point_iterator >;
+    using randombox_type = randombox< value_type >;
+
+    std::ostream & log_;
+    thread_pool & thread_pool_;
+
+    benchmark(std::ostream & _log,
+              thread_pool & _thread_pool)
+        : log_(_log)
+        , thread_pool_(_thread_pool)
+    { ; }
+
+    typename randombox_type::seed_type seed_ = 1;
+    size_type min_dimension_ = 2;
+    size_type max_dimension_ = 12;
+    size_type min_count_ = 100;
+    size_type max_count_ = 10000000;
+    size_type max_verified_count_ = 100000; // other ways to build the hull are compared with full build up to this count of points
+    size_type max_batched_count_ = 10000; // the same for hulls of small subsets of the points
+    double time_limit_ = 10.0; // seconds, greater counts of points are skipped for the body and dimension, if exceeded
+
+    struct result
+    {
+
+        std::string input_;
+        size_type dimension_ = 0;
+        size_type count_ = 0;
+        size_type basis_size_ = 0; // less than dimension_ + 1 for degenerate input
+        size_type facets_count_ = 0;
+        bool valid_ = false;
+        // microseconds
+        long long generate_time_ = 0;
+        long long basis_time_ = 0;
+        long long simplex_time_ = 0;
+        long long hull_time_ = 0;
+        long long check_time_ = 0;
+#if defined(QUICKHULL_STATISTICS)
+        quick_hull_statistics statistics_;
+#endif
+
+        double
+        seconds() const
+        {
+            return double(generate_time_ + basis_time_ + simplex_time_ + hull_time_ + check_time_) * 1E-6;
+        }
+
+    };
+
+    std::vector< result > results_;
+
+    template< typename function >
+    static
+    long long
+    measure(function && _function)
+    {
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        using std::chrono::steady_clock;
+        steady_clock::time_point const start = steady_clock::now();
+        _function();
+        return duration_cast< microseconds >(steady_clock::now() - start).count();
+    }
+
+    static
+    std::vector< value_type >
+    vertices(quick_hull_type const & _quick_hull) // coordinates of vertices of the hull in lexicographical order
+    {
+        size_type const dimension_ = _quick_hull.dimension_;
+        auto const & points_ = _quick_hull.facets_.points_;
+        auto indices_ = _quick_hull.facets_.vertices_;
+        std::sort(std::begin(indices_), std::end(indices_));
+        indices_.erase(std::unique(std::begin(indices_), std::end(indices_)), std::end(indices_));
+        std::sort(std::begin(indices_), std::end(indices_), [&] (auto const l, auto const r) -> bool
+        {
+            return std::lexicographical_compare(points_[l].data(), points_[l].data() + dimension_, points_[r].data(), points_[r].data() + dimension_);
+        });
+        std::vector< value_type > vertices_;
+        vertices_.reserve(indices_.size() * dimension_);
+        for (auto const p : indices_) {
+            auto const & point_ = points_[p];
+            vertices_.insert(std::cend(vertices_), point_.data(), point_.data() + dimension_);
+        }
+        return vertices_;
+    }
+
+    void
+    run(result & _result,
+        std::vector< value_type > const & _coordinates,
+        std::vector< value_type > * const _vertices = nullptr) const // coordinates of vertices are stored into *_vertices, if specified
+    {
+        size_type const dimension_ = _result.dimension_;
+        value_type const eps = std::numeric_limits< value_type >::epsilon();
+        quick_hull_type quick_hull_(dimension_, eps);
+        quick_hull_.thread_pool_ = &thread_pool_;
+        quick_hull_.concurrent_apexes_ = 4 * thread_pool_.size();
+        quick_hull_.add_points(_coordinates.data(), _result.count_, dimension_); // rows are referenced in place
+        typename quick_hull_type::point_list initial_simplex_;
+        _result.basis_time_ = measure([&] { initial_simplex_ = quick_hull_.get_affine_basis(); });
+        _result.basis_size_ = initial_simplex_.size();
+        if (_result.basis_size_ != dimension_ + 1) {
+            return;
+        }
+        _result.simplex_time_ = measure([&] { quick_hull_.create_initial_simplex(std::cbegin(initial_simplex_), std::prev(std::cend(initial_simplex_))); });
+        _result.hull_time_ = measure([&] { quick_hull_.create_convex_hull(); });
+        _result.facets_count_ = quick_hull_.facets_.size();
+        _result.check_time_ = measure([&] { _result.valid_ = quick_hull_.check(); });
+#if defined(QUICKHULL_STATISTICS)
+        _result.statistics_ = quick_hull_.statistics_;
+#endif
+        if (_vertices) {
+            *_vertices = vertices(quick_hull_);
+        }
+    }
+
+    static
+    bool
+    contains(quick_hull_type const & _quick_hull,
+             std::vector< value_type > const & _coordinates,
+             size_type const _dimension) // all the points lie below each facet within roundoff error
+    {
+        value_type const tolerance_ = std::sqrt(std::numeric_limits< value_type >::epsilon());
+        for (auto const facet_ : _quick_hull.facets_) {
+            for (auto x = _coordinates.data(); x != _coordinates.data() + _coordinates.size(); x += _dimension) {
+                if (tolerance_ < facet_.distance(x)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static
+    bool
+    covers(quick_hull_type const & _quick_hull,
+           std::vector< value_type > const & _vertices) // vertices of another hull either are vertices of the hull or lie below each facet within roundoff error
+    {
+        size_type const dimension_ = _quick_hull.dimension_;
+        std::vector< value_type > const own_vertices_ = vertices(_quick_hull);
+        std::vector< value_type const * > rows_;
+        for (auto x = own_vertices_.data(); x != own_vertices_.data() + own_vertices_.size(); x += dimension_) {
+            rows_.push_back(x);
+        }
+        auto const less_ = [&] (value_type const * const _lhs, value_type const * const _rhs) -> bool
+        {
+            return std::lexicographical_compare(_lhs, _lhs + dimension_, _rhs, _rhs + dimension_);
+        };
+        std::vector< value_type > rest_;
+        for (auto x = _vertices.data(); x != _vertices.data() + _vertices.size(); x += dimension_) {
+            if (!std::binary_search(std::cbegin(rows_), std::cend(rows_), x, less_)) {
+                rest_.insert(std::cend(rest_), x, x + dimension_);
+            }
+        }
+        return contains(_quick_hull, rest_, dimension_);
+    }
+
+    void
+    run_insert(result & _result,
+               std::vector< value_type > const & _coordinates) const // the hull of the first half of points is updated by insert_points with the rest
+    {
+        size_type const dimension_ = _result.dimension_;
+        size_type const half_ = _result.count_ / 2;
+        value_type const eps = std::numeric_limits< value_type >::epsilon();
+        quick_hull_type quick_hull_(dimension_, eps);
+        quick_hull_.add_points(_coordinates.data(), half_, dimension_);
+        typename quick_hull_type::point_list initial_simplex_;
+        _result.basis_time_ = measure([&] { initial_simplex_ = quick_hull_.get_affine_basis(); });
+        _result.basis_size_ = initial_simplex_.size();
+        if (_result.basis_size_ != dimension_ + 1) {
+            return;
+        }
+        _result.simplex_time_ = measure([&] { quick_hull_.create_initial_simplex(std::cbegin(initial_simplex_), std::prev(std::cend(initial_simplex_))); });
+        quick_hull_.create_convex_hull();
+        point_iterator const beg{_coordinates.data() + half_ * dimension_, dimension_, dimension_};
+        point_iterator const end{_coordinates.data() + _result.count_ * dimension_, dimension_, dimension_};
+        _result.hull_time_ = measure([&] { quick_hull_.insert_points(beg, end); });
+        _result.facets_count_ = quick_hull_.facets_.size();
+        _result.check_time_ = measure([&] { _result.valid_ = quick_hull_.check() && contains(quick_hull_, _coordinates, dimension_); });
+#if defined(QUICKHULL_STATISTICS)
+        _result.statistics_ = quick_hull_.statistics_;
+#endif
+    }
+
+    void
+    verify(result & _result,
+           quick_hull_type const & _quick_hull,
+           std::vector< value_type > const & _vertices) const // the hull contains vertices of full build, therefore all the points
+    {
+        _result.basis_size_ = ((_quick_hull.facets_.size() == 0) ? 0 : (_result.dimension_ + 1));
+        _result.facets_count_ = _quick_hull.facets_.size();
+        _result.check_time_ = measure([&] { _result.valid_ = _quick_hull.check() && covers(_quick_hull, _vertices); });
+    }
+
+    void
+    run_parallel(result & _result,
+                 std::vector< value_type > const & _coordinates,
+                 std::vector< value_type > const & _vertices) const // divide and conquer by parallel_convex_hull
+    {
+        size_type const dimension_ = _result.dimension_;
+        value_type const eps = std::numeric_limits< value_type >::epsilon();
+        point_iterator const beg{_coordinates.data(), dimension_, dimension_};
+        point_iterator const end{_coordinates.data() + _result.count_ * dimension_, dimension_, dimension_};
+        size_type const threads_ = std::max(thread_pool_.size(), size_type(4)); // input is divided into several slabs even on a single core
+        std::optional< quick_hull_type > quick_hull_;
+        _result.hull_time_ = measure([&] { quick_hull_.emplace(parallel_convex_hull(beg, end, dimension_, eps, threads_)); });
+        verify(_result, *quick_hull_, _vertices);
+    }
+
+    void
+    run_stream(result & _result,
+               std::vector< value_type > const & _coordinates,
+               std::vector< value_type > const & _vertices) const // the points are consumed by quick_hull_stream in 10 chunks
+    {
+        size_type const dimension_ = _result.dimension_;
+        value_type const eps = std::numeric_limits< value_type >::epsilon();
+        quick_hull_stream< value_type > quick_hull_stream_(dimension_, eps, _result.count_ / 10 + 1);
+        quick_hull_stream_.hull_.thread_pool_ = &thread_pool_;
+        size_type offset_ = 0;
+        _result.hull_time_ = measure([&] {
+            quick_hull_stream_.add_points([&] (value_type * const _chunk, size_type const _count) -> size_type
+            {
+                size_type const size_ = std::min(_count, _result.count_ - offset_);
+                std::copy_n(_coordinates.data() + offset_ * dimension_, size_ * dimension_, _chunk);
+                offset_ += size_;
+                return size_;
+            });
+        });
+        verify(_result, quick_hull_stream_.hull_, _vertices);
+    }
+
+    void
+    run_batch(result & _result,
+              std::vector< value_type > const & _coordinates) const // the points are divided into small sets of sizes from 1 to 2 * (dimension + 1), hulls of the sets by quick_hull_batch should be the same as the hulls built one by one
+    {
+        size_type const dimension_ = _result.dimension_;
+        value_type const eps = std::numeric_limits< value_type >::epsilon();
+        std::vector< size_type > offsets_{0};
+        for (size_type c = 0; !(_result.count_ < offsets_.back() + c % (2 * (dimension_ + 1)) + 1); ++c) {
+            offsets_.push_back(offsets_.back() + c % (2 * (dimension_ + 1)) + 1);
+        }
+        size_type const sets_ = offsets_.size() - 1;
+        std::vector< size_type > facets_offsets_{0}; // hulls built one by one
+        std::vector< typename quick_hull_type::point_index > vertices_;
+        for (size_type c = 0; c < sets_; ++c) {
+            value_type const * const first_ = _coordinates.data() + offsets_[c] * dimension_;
+            size_type const size_ = offsets_[c + 1] - offsets_[c];
+            if (dimension_ < size_) {
+                quick_hull_type quick_hull_(dimension_, eps);
+                quick_hull_.add_points(first_, size_, dimension_);
+                auto const basis_ = quick_hull_.get_affine_basis();
+                if (basis_.size() == dimension_ + 1) {
+                    quick_hull_.create_initial_simplex(std::cbegin(basis_), std::prev(std::cend(basis_)));
+                    quick_hull_.create_convex_hull();
+                    for (auto const & facet_ : quick_hull_.facets_) {
+                        for (auto const & vertex_ : facet_.vertices_) {
+                            vertices_.push_back(typename quick_hull_type::point_index(size_type(vertex_.data() - first_) / dimension_));
+                        }
+                    }
+                }
+            }
+            facets_offsets_.push_back(vertices_.size() / dimension_);
+        }
+        quick_hull_batch< value_type > quick_hull_batch_(dimension_, eps, thread_pool_);
+        _result.hull_time_ = measure([&] { quick_hull_batch_(_coordinates.data(), offsets_.data(), sets_); });
+        _result.basis_size_ = dimension_ + 1;
+        _result.facets_count_ = quick_hull_batch_.offsets_.back();
+        _result.valid_ = ((quick_hull_batch_.offsets_ == facets_offsets_) && (quick_hull_batch_.vertices_ == vertices_));
+        quick_hull_batch_(_coordinates.data(), offsets_.data(), sets_); // state of workers is retained
+        _result.valid_ = _result.valid_ && ((quick_hull_batch_.offsets_ == facets_offsets_) && (quick_hull_batch_.vertices_ == vertices_));
+    }
+
+    std::vector< value_type >
+    generate(std::string const & _body,
+             size_type const _dimension,
+             size_type const _count) const
+    {
+        randombox_type randombox_;
+        randombox_.set_seed(seed_);
+        randombox_.thread_pool_ = &thread_pool_;
+        size_type const dimension_ = ((_body == "simplex") ? (_dimension + 1) : _dimension); // solid simplex is projection of unit simplex of higher dimension
+        randombox_.set_dimension(dimension_);
+        randombox_.set_count(_count);
+        if (_body == "sphere") {
+            randombox_.add_sphere_blocks();
+        } else if (_body == "ball") {
+            randombox_.add_ball_blocks();
+        } else if (_body == "cube") {
+            randombox_.add_unit_cube_blocks();
+        } else if (_body == "simplex") {
+            randombox_.add_unit_simplex();
+        } else if (_body == "diamond-surface") {
+            randombox_.add_diamond_surface();
+        } else if (_body == "diamond-solid") {
+            randombox_.add_diamond_solid();
+        } else {
+            throw std::runtime_error("unsupported geometrical object '" + _body + "'");
+        }
+        std::vector< value_type > coordinates_;
+        coordinates_.reserve(_count * _dimension);
+        for (auto const & point_ : randombox_.resulting_points_) {
+            std::copy_n(std::begin(point_), _dimension, std::back_inserter(coordinates_));
+        }
+        coordinates_.insert(std::cend(coordinates_), std::cbegin(randombox_.coordinates_), std::cend(randombox_.coordinates_));
+        return coordinates_;
+    }
+
+    bool
+    agree(result && _result,
+          result const & _full_result,
+          char const * const _name) // _result of another way to build the hull should be valid and should have the same count of facets, whenever full build is valid
+    {
+        bool const agreed_ = (!_full_result.valid_ || (_result.valid_ && (_result.facets_count_ == _full_result.facets_count_)));
+        add(std::move(_result));
+        if (!agreed_) {
+            log_ << "error: " << _full_result.input_ << " D" << _full_result.dimension_ << " N" << _full_result.count_ << ": " << _name << " does not agree with full build" << std::endl;
+        }
+        return agreed_;
+    }
+
+    void
+    add(result && _result)
+    {
+        log_ << _result.input_ << " D" << _result.dimension_ << " N" << _result.count_
+             << ": basis " << _result.basis_time_ << "us, simplex " << _result.simplex_time_
+             << "us, hull " << _result.hull_time_ << "us, check " << _result.check_time_
+             << "us, facets " << _result.facets_count_ << (_result.valid_ ? "" : " (not valid)") << std::endl;
+        results_.push_back(std::move(_result));
+    }
+
+    bool
+    run_bodies() // up to max_verified_count_ points the hull is also built by parallel_convex_hull and by quick_hull_stream, hulls of small subsets are built by quick_hull_batch, the results should agree with serial builds
+    {
+        bool success_ = true;
+        for (std::string const body_ : {"sphere", "ball", "cube", "simplex", "diamond-surface", "diamond-solid"}) {
+            for (size_type dimension_ = min_dimension_; !(max_dimension_ < dimension_); ++dimension_) {
+                for (size_type count_ = min_count_; !(max_count_ < count_); count_ *= 10) {
+                    result result_;
+                    result_.input_ = body_;
+                    result_.dimension_ = dimension_;
+                    result_.count_ = count_;
+                    std::vector< value_type > coordinates_;
+                    result_.generate_time_ = measure([&] { coordinates_ = generate(body_, dimension_, count_); });
+                    bool const verified_ = !(max_verified_count_ < count_);
+                    std::vector< value_type > vertices_;
+                    run(result_, coordinates_, (verified_ ? &vertices_ : nullptr));
+                    bool const exceeded_ = (time_limit_ < result_.seconds());
+                    result const full_result_ = result_;
+                    add(std::move(result_));
+                    if (verified_) {
+                        result parallel_result_;
+                        parallel_result_.input_ = body_ + " (parallel)";
+                        parallel_result_.dimension_ = dimension_;
+                        parallel_result_.count_ = count_;
+                        run_parallel(parallel_result_, coordinates_, vertices_);
+                        success_ &= agree(std::move(parallel_result_), full_result_, "parallel_convex_hull");
+                        result stream_result_;
+                        stream_result_.input_ = body_ + " (stream)";
+                        stream_result_.dimension_ = dimension_;
+                        stream_result_.count_ = count_;
+                        run_stream(stream_result_, coordinates_, vertices_);
+                        if (body_ == "diamond-surface") { // the points lie on facets within roundoff error: vertices of the hulls of subsets, which are built for each chunk, depend on the order of processing
+                            add(std::move(stream_result_));
+                        } else {
+                            success_ &= agree(std::move(stream_result_), full_result_, "quick_hull_stream");
+                        }
+                    }
+                    if (!(max_batched_count_ < count_)) {
+                        result batch_result_;
+                        batch_result_.input_ = body_ + " (batch)";
+                        batch_result_.dimension_ = dimension_;
+                        batch_result_.count_ = count_;
+                        run_batch(batch_result_, coordinates_);
+                        bool const batched_ = batch_result_.valid_;
+                        add(std::move(batch_result_));
+                        if (!batched_) {
+                            log_ << "error: " << body_ << " D" << dimension_ << " N" << count_ << ": quick_hull_batch does not agree with hulls of the sets built one by one" << std::endl;
+                            success_ = false;
+                        }
+                    }
+                    if (exceeded_) {
+                        break;
+                    }
+                }
+            }
+        }
+        return success_;
+    }
+
+    bool
+    run_samples(std::string const & _directory) // every sample is processed twice: by full build and by insert_points, the latter should be valid whenever the former is; samples named flat* must be found degenerate
+    {
+        std::error_code error_code_;
+        std::vector< std::filesystem::path > paths_;
+        for (auto const & entry_ : std::filesystem::directory_iterator(_directory, error_code_)) {
+            paths_.push_back(entry_.path());
+        }
+        if (error_code_) {
+            log_ << "cannot list directory '" << _directory << "': " << error_code_.message() << std::endl;
+            return false;
+        }
+        std::sort(std::begin(paths_), std::end(paths_));
+        bool success_ = true;
+        for (auto const & path_ : paths_) {
+            point_file< value_type > input_;
+            if (!input_.open(path_.c_str(), &thread_pool_)) {
+                log_ << "error: " << path_ << ": " << input_.error_ << std::endl;
+                return false;
+            }
+            result result_;
+            result_.input_ = path_.filename().string();
+            result_.dimension_ = input_.dimension_;
+            result_.count_ = input_.size();
+            std::vector< value_type > const coordinates_(input_.data(), input_.data() + input_.size() * input_.dimension_);
+            result insert_result_ = result_;
+            insert_result_.input_ += " (insert)";
+            run(result_, coordinates_);
+            bool const valid_ = result_.valid_;
+            bool const flat_ = (result_.input_.compare(0, 4, "flat") == 0); // lies in a proper affine subspace within eps
+            bool const rejected_ = (result_.basis_size_ != result_.dimension_ + 1);
+            add(std::move(result_));
+            if (flat_ != rejected_) {
+                log_ << "error: " << path_ << ": affine basis is " << (rejected_ ? "not complete" : "complete") << std::endl;
+                success_ = false;
+            }
+            if (input_.dimension_ < insert_result_.count_ / 2) {
+                run_insert(insert_result_, coordinates_);
+                bool const agreed_ = (insert_result_.valid_ || !valid_);
+                add(std::move(insert_result_));
+                if (!agreed_) {
+                    log_ << "error: " << path_ << ": insert_points does not agree with full build" << std::endl;
+                    success_ = false;
+                }
+            }
+        }
+        return success_;
+    }
+
+    static
+    void
+    write_string(std::ostream & _out,
+                 std::string const & _string) // JSON string literal
+    {
+        _out << '"';
+        for (char const c : _string) {
+            switch (c) {
+            case '"' : _out << "\\\""; break;
+            case '\\' : _out << "\\\\"; break;
+            case '\n' : _out << "\\n"; break;
+            case '\r' : _out << "\\r"; break;
+            case '\t' : _out << "\\t"; break;
+            default : {
+                if (static_cast< unsigned char >(c) < 0x20) { // other control characters
+                    char const digits_[] = "0123456789abcdef";
+                    _out << "\\u00" << digits_[(c >> 4) & 0xF] << digits_[c & 0xF];
+                } else {
+                    _out << c;
+                }
+                break;
+            }
+            }
+        }
+        _out << '"';
+    }
+
+    std::ostream &
+    operator () (std::ostream & _out) const // JSON
+    {
+        _out << "{\n"
+                "  \"seed\": " << seed_ << ",\n"
+                "  \"threads\": " << thread_pool_.size() << ",\n"
+                "  \"results\": [";
+        bool first_ = true;
+        for (result const & result_ : results_) {
+            _out << (first_ ? "\n" : ",\n");
+            first_ = false;
+            _out << "    {\"input\": ";
+            write_string(_out, result_.input_);
+            _out << ", \"dimension\": " << result_.dimension_
+                 << ", \"count\": " << result_.count_
+                 << ", \"basis_size\": " << result_.basis_size_
+                 << ", \"facets\": " << result_.facets_count_
+                 << ", \"valid\": " << (result_.valid_ ? "true" : "false")
+                 << ", \"generate_us\": " << result_.generate_time_
+                 << ", \"get_affine_basis_us\": " << result_.basis_time_
+                 << ", \"create_initial_simplex_us\": " << result_.simplex_time_
+                 << ", \"create_convex_hull_us\": " << result_.hull_time_
+                 << ", \"check_us\": " << result_.check_time_;
+#if defined(QUICKHULL_STATISTICS)
+            _out << ", \"statistics\": {";
+            char const * separator_ = "";
+            result_.statistics_.visit([&] (char const * const _name, size_type const _value)
+            {
+                _out << separator_ << '"' << _name << "\": " << _value;
+                separator_ = ", ";
+            });
+            _out << "}";
+#endif
+            _out << "}";
+        }
+        _out << "\n  ]\n"
+                "}\n";
+        return _out;
+    }
+
+};
+
+int
+main(int argc, char * argv[]) // bin/benchmark [result.json [max dimension [max count [time limit in seconds]]]]
+{
+    std::ostream & log_ = std::clog;
+
+    thread_pool thread_pool_;
+    benchmark benchmark_(log_, thread_pool_);
+    if (2 < argc) {
+        benchmark_.max_dimension_ = std::strtoull(argv[2], nullptr, 10);
+    }
+    if (3 < argc) {
+        benchmark_.max_count_ = std::strtoull(argv[3], nullptr, 10);
+    }
+    if (4 < argc) {
+        benchmark_.time_limit_ = std::strtod(argv[4], nullptr);
+    }
+    bool const bodies_ = benchmark_.run_bodies();
+    bool const samples_ = benchmark_.run_samples(QUICKHULL_SAMPLES_DIR); // results are written anyways
+    if (1 < argc) {
+        std::ofstream json_(argv[1]);
+        if (!json_) {
+            log_ << "error: cannot open file '" << argv[1] << "'" << std::endl;
+            return EXIT_FAILURE;
+        }
+        benchmark_(json_);
+    } else {
+        benchmark_(std::cout);
+    }
+    return ((bodies_ && samples_) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -2,11 +2,11 @@
 #include <iostream>
 #endif
 #include <quickhull.hpp>
+#include <point_file.hpp>
 
 #include <iostream>
 #include <ostream>
 #include <fstream>
-#include <sstream>
 #include <string>
 #include <chrono>
 #include <set>
@@ -64,86 +64,32 @@ struct test_quickhull
     size_type count_ = 0;
     points points_;
 
-    std::string line_;
-    std::istringstream iss_;
-
     bool
-    input(std::istream & _in)
+    input(point_file< value_type > const & _input)
     {
-        {
-            if (!std::getline(_in, line_)) {
-                err_ << "error: input: missing dimension line" << std::endl;
-                return false;
-            }
-            iss_.str(line_);
-            if (!(iss_ >> dimension_)) {
-                err_ << "error: input: dimension format" << std::endl;
-                return false;
-            }
-            log_ << "dimensionality of input is " << dimension_ << std::endl;
-            if (!(1 < dimension_)) {
-                err_ << "error: input: dimensionality value is not greater then one" << std::endl;
-                return false;
-            }
-            {
-                using char_type = typename std::istream::char_type;
-                log_ << "rbox command line:";
-                std::istreambuf_iterator< char_type > const ibeg(iss_), iend;
-                std::copy(ibeg, iend, std::ostreambuf_iterator< char_type >(log_));
-                log_ << std::endl;
-            }
-            iss_.clear();
+        dimension_ = _input.dimension_;
+        log_ << "dimensionality of input is " << dimension_ << std::endl;
+        if (!(1 < dimension_)) {
+            err_ << "error: input: dimensionality value is not greater then one" << std::endl;
+            return false;
         }
-        {
-            if (!std::getline(_in, line_)) {
-                err_ << "error: input: missing count line" << std::endl;
-                return false;
-            }
-            iss_.str(line_);
-            if (!(iss_ >> count_)) {
-                err_ << "error: input: format of count" << std::endl;
-                return false;
-            }
-            iss_.clear();
-            log_ << "input points count = " << count_ << std::endl;
-            if (!(dimension_ < count_)) {
-                err_ << "error: input: points count is not greater than to dimensionality" << std::endl;
-                return false;
-            }
+        log_ << "rbox command line:" << _input.header_ << std::endl;
+        count_ = _input.size();
+        log_ << "input points count = " << count_ << std::endl;
+        if (!(dimension_ < count_)) {
+            err_ << "error: input: points count is not greater than to dimensionality" << std::endl;
+            return false;
         }
         points_ = points(count_);
+        value_type const * row_ = _input.data();
         for (point & point_ : points_) {
-            if (!std::getline(_in, line_)) {
-                err_ << "error: input: wrong line count" << std::endl;
-                return false;
-            }
             point_.resize(dimension_);
-            {
-                iss_.str(line_);
-                auto c = std::begin(point_);
-                for (size_type j = 0; j < dimension_; ++j) {
-                    if (!(iss_ >> *c)) {
-                        err_ << "error: input: bad corodinate value at line " << j << " of data" << std::endl;
-                        return false;
-                    }
-                    ++c;
-                }
-                iss_.clear();
-            }
+            std::copy_n(row_, dimension_, std::begin(point_));
+            row_ += std::ptrdiff_t(dimension_);
         }
         return true;
     }
 
-    friend
-    std::istream &
-    operator >> (std::istream & _in, test_quickhull & _qh)
-    {
-        if (!_qh.input(_in)) {
-            _in.setstate(std::ios::failbit);
-        }
-        return _in;
-    }
-
     struct gnuplot
     {
 
@@ -397,9 +343,10 @@ struct test_quickhull
                 auto ibeg = std::cbegin(universe_);
                 auto const iend = std::cend(universe_);
                 auto sbeg = std::cbegin(surface_points_);
+                auto const send = std::cend(surface_points_);
                 point_iterator_less point_iterator_less_;
-                assert(sbeg != std::cend(surface_points_));
-                while (ibeg != iend) {
+                assert(sbeg != send);
+                while ((ibeg != iend) && (sbeg != send)) { // the rest of universe_ lies inside, when surface points are over
                     if (point_iterator_less_(*ibeg, *sbeg)) {
                         ++ibeg;
                     } else {
@@ -411,7 +358,7 @@ struct test_quickhull
                 }
             }
             initial_simplex_.clear();
-            quick_hull_.facets_.clear();
+            quick_hull_.reset();
             return (quick_hull_.dimension_ < universe_.size());
         }
 
@@ -441,18 +388,6 @@ main(int argc, char * argv[]) // rbox D3 t 100 | quickhull | gnuplot -p
 
     log_ << "input file: " << ((argc < 2) ? "stdin" : argv[1]) << std::endl;
 
-    std::ifstream ifs_;
-    if (argc == 2) {
-        ifs_.open(argv[1]);
-        if (!ifs_.is_open()) {
-            err_ << "error: cannot open file '" << argv[1] << "'" << std::endl;
-            return EXIT_FAILURE;
-        }
-    }
-
-    std::istream & in_ = (ifs_.is_open() ? ifs_ : std::cin);
-    in_.sync_with_stdio(false);
-
 #if 0
     // RandomAccessIterator
     using value_type = float;
@@ -466,8 +401,16 @@ main(int argc, char * argv[]) // rbox D3 t 100 | quickhull | gnuplot -p
 #endif
     test_quickhull< value_type, point, points > test_quickhull_(err_, log_);
 
-    if (!(in_ >> test_quickhull_)) {
-        return EXIT_FAILURE;
+    {
+        thread_pool thread_pool_;
+        point_file< value_type > input_;
+        if (!((argc == 2) ? input_.open(argv[1], &thread_pool_) : input_.read(std::cin, &thread_pool_))) { // file is memory-mapped, coordinates are parsed concurrently (binary ones are copied from the mapping once)
+            err_ << "error: " << input_.error_ << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (!test_quickhull_.input(input_)) {
+            return EXIT_FAILURE;
+        }
     }
 
     auto gnuplot_ = test_quickhull_();
@@ -2,19 +2,17 @@
 #include <iostream>
 #endif
 #include <quickhull.hpp>
+#include <point_file.hpp>
 
 #include <limits>
 #include <iterator>
 #include <algorithm>
-#include <valarray>
 #include <vector>
-#include <forward_list>
 #include <string>
 #include <iostream>
 #include <istream>
 #include <ostream>
 #include <fstream>
-#include <sstream>
 
 #include <cmath>
 #include <cstdlib>
@@ -33,113 +31,59 @@
 #endif
 
 int
-main(int argc, char * argv[]) // rbox D3 t 100 | bin/qh | gnuplot -p
+main(int argc, char * argv[]) // rbox D3 t 100 | bin/qh | gnuplot -p or bin/qh points.bin hull.bin
 {
     std::ostream & err_ = std::cerr;
     std::ostream & log_ = std::clog;
 
-    // choose input source
-    std::ifstream ifs_;
-    if (argc == 2) {
-        ifs_.open(argv[1]);
-        if (!ifs_.is_open()) {
-            err_ << "error: cannot open file '" << argv[1] << "'" << std::endl;
-            return EXIT_FAILURE;
-        }
-    }
-    std::istream & in_ = (ifs_.is_open() ? ifs_ : std::cin);
     using size_type = std::size_t;
-
-    // select types
-#if 0
-    // RandomAccessIterator
-    using value_type = float;
-    using point = std::valarray< value_type >;
-    using points = std::vector< point >;
-#else
-    // ForwardIterator
     using value_type = double;
-    using point = std::forward_list< value_type >;
-    using points = std::forward_list< point >;
-#endif
 
-    std::string line_;
-    std::istringstream iss_;
-
-    // fill container with points
-    size_type dimension_ = 0;
-    {
-        if (!std::getline(in_, line_)) {
-            err_ << "error: input: missing dimension line" << std::endl;
-            return false;
-        }
-        iss_.str(line_);
-        if (!(iss_ >> dimension_)) {
-            err_ << "error: input: dimension format" << std::endl;
-            return false;
-        }
-        log_ << "dimensionality of input is " << dimension_ << std::endl;
-        if (!(1 < dimension_)) {
-            err_ << "error: input: dimensionality value is not greater then one" << std::endl;
-            return false;
-        }
-        {
-            using char_type = typename std::istream::char_type;
-            log_ << "rbox command line:";
-            std::istreambuf_iterator< char_type > const ibeg(iss_), iend;
-            std::copy(ibeg, iend, std::ostreambuf_iterator< char_type >(log_));
-            log_ << std::endl;
-        }
-        iss_.clear();
+    // read input: file (memory-mapped, binary one is not copied) or stdin
+    thread_pool thread_pool_;
+    point_file< value_type > input_;
+    if (!((1 < argc) ? input_.open(argv[1], &thread_pool_) : input_.read(std::cin, &thread_pool_))) { // coordinates of points are parsed concurrently
+        err_ << "error: " << input_.error_ << std::endl;
+        return EXIT_FAILURE;
     }
-    size_type count_ = 0;
-    {
-        if (!std::getline(in_, line_)) {
-            err_ << "error: input: missing count line" << std::endl;
-            return false;
-        }
-        iss_.str(line_);
-        if (!(iss_ >> count_)) {
-            err_ << "error: input: format of count" << std::endl;
-            return false;
-        }
-        iss_.clear();
-        log_ << "input points count = " << count_ << std::endl;
-        if (!(dimension_ < count_)) {
-            err_ << "error: input: points count is not greater then dimensionality" << std::endl;
-            return false;
-        }
+    size_type const dimension_ = input_.dimension_;
+    log_ << "dimensionality of input is " << dimension_ << std::endl;
+    log_ << "rbox command line:" << input_.header_ << std::endl;
+    if (!(1 < dimension_)) {
+        err_ << "error: input: dimensionality value is not greater then one" << std::endl;
+        return false;
     }
-    points points_(count_);
-    for (point & point_ : points_) {
-        if (!std::getline(in_, line_)) {
-            err_ << "error: input: wrong line count" << std::endl;
-            return false;
-        }
-        point_.resize(dimension_);
-        {
-            iss_.str(line_);
-            auto c = std::begin(point_);
-            for (size_type j = 0; j < dimension_; ++j) {
-                if (!(iss_ >> *c)) {
-                    err_ << "error: input: bad corodinate value at line " << j << " of data" << std::endl;
-                    return false;
-                }
-                ++c;
-            }
-            iss_.clear();
-        }
+    size_type const count_ = input_.size();
+    log_ << "input points count = " << count_ << std::endl;
+    if (!(dimension_ < count_)) {
+        err_ << "error: input: points count is not greater then dimensionality" << std::endl;
+        return false;
     }
 
+    // points are rows of contiguous buffer
+    using point_iterator = row_iterator< value_type >;
+    point_iterator const points_begin_(input_.data(), dimension_, dimension_);
+    point_iterator const points_end_ = points_begin_ + std::ptrdiff_t(count_);
+
     // set epsilon (can be zero)
     //value_type const zero = value_type(0);
     value_type const eps = std::numeric_limits< value_type >::epsilon();
     log_ << "epsilon = " << eps << std::endl;
 
     // define and setup QH class instance
-    using quick_hull_type = quick_hull< typename points::const_iterator >;
+    using quick_hull_type = quick_hull< point_iterator >;
+    //using quick_hull_type = quick_hull< point_iterator, value_type, 0, std::pmr::polymorphic_allocator< value_type > >; // pass memory resource (e.g. std::pmr::monotonic_buffer_resource) as third argument of constructor
     quick_hull_type quick_hull_(dimension_, eps); // (1)
-    quick_hull_.add_points(std::cbegin(points_), std::cend(points_)); // (2)
+    //quick_hull_.cofactor_hyperplanes_ = true; // former O(d^4) way to calculate equations of hyperplanes
+    //quick_hull_.monotone_chain_ = false; // use general algorithm for planar input too
+    quick_hull_.thread_pool_ = &thread_pool_; // partition large sets of points concurrently
+    quick_hull_.concurrent_apexes_ = 4 * thread_pool_.size(); // process several apexes with disjoint visible regions per round
+#if 0
+    quick_hull_.add_points(input_.data(), count_, dimension_); // (2)
+#else
+    size_type const culled_ = quick_hull_.add_points_filtered(points_begin_, points_end_); // (2) discard points lying strictly inside of the hull of extreme points
+    log_ << "culled points count = " << culled_ << std::endl;
+#endif
     auto const initial_simplex_ = quick_hull_.get_affine_basis(); // (3)
 
     // run the algorithm
@@ -147,17 +91,17 @@ main(int argc, char * argv[]) // rbox D3 t 100 | bin/qh | gnuplot -p
     using std::chrono::microseconds;
     using std::chrono::steady_clock;
     { // create initial simplex
-        steady_clock::time_point const start = steady_clock::now();
-        quick_hull_.create_initial_simplex(std::cbegin(initial_simplex_),
-                                           std::prev(std::cend(initial_simplex_))); // (4)
-        auto const delta = duration_cast< microseconds >(steady_clock::now() - start).count();
-        log_ << "simplex time = " << delta << "us" << std::endl;
         size_type const basis_size_ = initial_simplex_.size();
         if (basis_size_ != quick_hull_.dimension_ + 1) { // (5)
             err_ << "error: algorithm: cannot construct a simplex. Degenerated input set. Size of basis: "
                       << basis_size_ << std::endl;
             return false;
         }
+        steady_clock::time_point const start = steady_clock::now();
+        quick_hull_.create_initial_simplex(std::cbegin(initial_simplex_),
+                                           std::prev(std::cend(initial_simplex_))); // (4)
+        auto const delta = duration_cast< microseconds >(steady_clock::now() - start).count();
+        log_ << "simplex time = " << delta << "us" << std::endl;
     }
     { // create convex hull
         steady_clock::time_point const start = steady_clock::now();
@@ -170,6 +114,9 @@ main(int argc, char * argv[]) // rbox D3 t 100 | bin/qh | gnuplot -p
     log_ << "number of (convex hull) polyhedron facets is "
               << TERM_COLOR_BLUE << quick_hull_.facets_.size()
               << TERM_COLOR_DEFAULT << std::endl;
+#if defined(QUICKHULL_STATISTICS)
+    log_ << quick_hull_.statistics_ << std::flush;
+#endif
     if (!quick_hull_.check()) {
         err_ << TERM_COLOR_RED << "error: algorithm: resulting structure is not valid convex polytope"
                   << TERM_COLOR_DEFAULT << std::endl;
@@ -177,6 +124,14 @@ main(int argc, char * argv[]) // rbox D3 t 100 | bin/qh | gnuplot -p
     }
 
     // output
+    if (argc == 3) { // binary hull: vertices, neighbours and equations of facets
+        std::ofstream hull_file_(argv[2], std::ios::binary);
+        if (!write_hull(hull_file_, quick_hull_, [&] (point_iterator const & _vertex) { return _vertex - points_begin_; })) {
+            err_ << "error: cannot write file '" << argv[2] << "'" << std::endl;
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
     std::ostream & gnuplot_ = std::cout;
     if (3 < quick_hull_.dimension_) {
         log_ << "dimensionality value " << quick_hull_.dimension_
@@ -207,7 +162,7 @@ main(int argc, char * argv[]) // rbox D3 t 100 | bin/qh | gnuplot -p
     gnuplot_ << ";\n";
     {
         for (auto const & v : initial_simplex_) {
-            point const & point_ = *v;
+            auto const point_ = *v;
             for (value_type const & coordinate_ : point_) {
                 gnuplot_ << coordinate_ << ' ';
             }
@@ -215,16 +170,16 @@ main(int argc, char * argv[]) // rbox D3 t 100 | bin/qh | gnuplot -p
         }
         gnuplot_ << "e\n";
         {
-            for (auto const & point_ : points_) {
-                for (value_type const & coordinate_ : point_) {
+            for (point_iterator p = points_begin_; p != points_end_; ++p) {
+                for (value_type const & coordinate_ : *p) {
                     gnuplot_ << coordinate_ << ' ';
                 }
                 gnuplot_ << '\n';
             }
             gnuplot_ << "e\n";
             size_type i = 0;
-            for (auto const & point_ : points_) {
-                for (value_type const & coordinate_ : point_) {
+            for (point_iterator p = points_begin_; p != points_end_; ++p) {
+                for (value_type const & coordinate_ : *p) {
                     gnuplot_ << coordinate_ << ' ';
                 }
                 gnuplot_ << i << '\n';